@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------
 
 #include "adjacency_list.h" 
+#include "parallel.h"
 #include <iostream>
 
 using namespace std;
@@ -34,6 +35,10 @@ AdjacencyList::AdjacencyList(int vertex_count)
     }
     
     number_of_edges = 0;
+    indexed = false;
+    block_size = 0;
+    block_used = 0;
+    free_nodes = nullptr;
 
     // create adjacency lists
     int size = number_of_vertices;
@@ -62,6 +67,10 @@ AdjacencyList::AdjacencyList(const AdjacencyList& rhs)
     number_of_edges = 0;
     adj_list_in = nullptr;
     adj_list_out = nullptr;
+    indexed = false;
+    block_size = 0;
+    block_used = 0;
+    free_nodes = nullptr;
     // call assignment operator
     *this = rhs;
 }
@@ -74,8 +83,9 @@ AdjacencyList& AdjacencyList::operator=(const AdjacencyList& rhs)
         // free memory
         make_empty();
         
-        // make new arrays
+        // make new arrays, with one block holding all of the nodes
         int size = rhs.number_of_vertices;
+        reserve_nodes(2 * rhs.number_of_edges);
         adj_list_out = new Node *[size];
         adj_list_in = new Node *[size];
 
@@ -88,7 +98,7 @@ AdjacencyList& AdjacencyList::operator=(const AdjacencyList& rhs)
             Node* currPtr = rhs.adj_list_out[i];
             while (currPtr != nullptr)
             {
-                Node* newNode = new Node();
+                Node* newNode = new_node();
                 newNode -> next = adj_list_out[i];
                 newNode -> edge = currPtr -> edge;
                 newNode -> vertex = currPtr -> vertex;
@@ -99,7 +109,7 @@ AdjacencyList& AdjacencyList::operator=(const AdjacencyList& rhs)
             currPtr = rhs.adj_list_in[i];
             while (currPtr != nullptr)
             {
-                Node* newNode = new Node();
+                Node* newNode = new_node();
                 newNode -> next = adj_list_in[i];
                 newNode -> edge = currPtr -> edge;
                 newNode -> vertex = currPtr -> vertex;
@@ -109,6 +119,14 @@ AdjacencyList& AdjacencyList::operator=(const AdjacencyList& rhs)
         }
         number_of_vertices = size;
         number_of_edges = rhs.number_of_edges;
+
+        // the index holds node pointers so it is rebuilt, not copied
+        indexed = rhs.indexed;
+        if (indexed)
+        {
+            build_edge_index();
+        }
+        notify_graph_assigned();
     }
     return *this;
 }
@@ -122,25 +140,50 @@ void AdjacencyList::set_edge(int v1, int edge_label, int v2)
         return;
     }
 
+    // with the index, the nodes of an existing edge are found directly
+    if (indexed)
+    {
+        unordered_map<long, EdgeNodes>::iterator it = edge_index.find(edge_key(v1, v2));
+        if (it != edge_index.end())
+        {
+            it -> second.out -> edge = edge_label;
+            it -> second.in -> edge = edge_label;
+            return;
+        }
+    }
+
     // if edge exists, update both lists, otherwise create node in both lists
-    if(!has_edge(v1, v2))
+    if(indexed || !has_edge(v1, v2))
     {
+        // a listener may keep the new edge out
+        if (!allow_new_edge(v1, v2))
+        {
+            return;
+        }
+
         // create new node for in list and add to front 
-        Node* inNode = new Node();
+        Node* inNode = new_node();
         inNode -> next = adj_list_in[v2];
         inNode -> edge = edge_label;
         inNode -> vertex = v1;
         adj_list_in[v2] = inNode;
 
         // create new node for out list and add to front
-        Node* outNode = new Node();
+        Node* outNode = new_node();
         outNode -> next = adj_list_out[v1];
         outNode -> edge = edge_label;
         outNode -> vertex = v2;
         adj_list_out[v1] = outNode;
 
+        if (indexed)
+        {
+            EdgeNodes nodes = {outNode, inNode};
+            edge_index[edge_key(v1, v2)] = nodes;
+        }
+
         // increment number of edges
         number_of_edges++;
+        notify_edge_added(v1, v2);
     }
     else
     {
@@ -162,6 +205,107 @@ void AdjacencyList::set_edge(int v1, int edge_label, int v2)
     }
 }
 
+// add or update each (v1, edge_label, v2) edge in the batch
+void AdjacencyList::set_edges(const Edges& edges)
+{
+    // listeners are told about each new edge in order
+    if (!listeners.empty())
+    {
+        Graph::set_edges(edges);
+        return;
+    }
+
+    int n = number_of_vertices;
+
+    // group the batch by v1 (dropping repeated edges)
+    vector<int> offsets, order;
+    group_edges(n, edges, offsets, order);
+
+    // find which edges are new, numbering them by v1
+    vector<char> isNew(order.size());
+    vector<int> newOffsets(n + 1, 0);
+    parallel_for(n, [&](int, int begin, int end) {
+        for (int v = begin; v < end; ++v)
+        {
+            for (int k = offsets[v]; k < offsets[v + 1]; ++k)
+            {
+                isNew[k] = !has_edge(v, get<2>(edges[order[k]]));
+                newOffsets[v + 1] += isNew[k];
+            }
+        }
+    });
+    for (int v = 0; v < n; ++v)
+    {
+        newOffsets[v + 1] += newOffsets[v];
+    }
+    int newCount = newOffsets[n];
+
+    if (newCount > 0)
+    {
+        // take the out nodes and then the in nodes from one block
+        reserve_nodes(2 * newCount);
+        Node* outNodes = &node_blocks.back()[block_used];
+        Node* inNodes = outNodes + newCount;
+        block_used += 2 * newCount;
+
+        // link the out nodes, where each thread owns a range of v1
+        parallel_for(n, [&](int, int begin, int end) {
+            for (int v = begin; v < end; ++v)
+            {
+                int j = newOffsets[v];
+                for (int k = offsets[v]; k < offsets[v + 1]; ++k)
+                {
+                    if (!isNew[k])
+                        continue;
+                    const tuple<int, int, int>& edge = edges[order[k]];
+                    outNodes[j].vertex = get<2>(edge);
+                    outNodes[j].edge = get<1>(edge);
+                    outNodes[j].next = adj_list_out[v];
+                    adj_list_out[v] = &outNodes[j];
+                    inNodes[j].vertex = v;
+                    inNodes[j].edge = get<1>(edge);
+                    j++;
+                }
+            }
+        });
+
+        // link the in nodes, where each thread owns a range of v2
+        vector<int> inOffsets, inOrder;
+        parallel_bucket(newCount, n, [&](int j) { return outNodes[j].vertex; }, inOffsets, inOrder);
+        parallel_for(n, [&](int, int begin, int end) {
+            for (int v = begin; v < end; ++v)
+            {
+                for (int k = inOffsets[v]; k < inOffsets[v + 1]; ++k)
+                {
+                    Node* inNode = &inNodes[inOrder[k]];
+                    inNode -> next = adj_list_in[v];
+                    adj_list_in[v] = inNode;
+                }
+            }
+        });
+
+        if (indexed)
+        {
+            for (int j = 0; j < newCount; ++j)
+            {
+                EdgeNodes nodes = {&outNodes[j], &inNodes[j]};
+                edge_index[edge_key(inNodes[j].vertex, outNodes[j].vertex)] = nodes;
+            }
+        }
+        number_of_edges += newCount;
+    }
+
+    // relabel the edges that were already in the graph
+    for (int k = 0; k < (int) order.size(); ++k)
+    {
+        if (!isNew[k])
+        {
+            const tuple<int, int, int>& edge = edges[order[k]];
+            set_edge(get<0>(edge), get<1>(edge), get<2>(edge));
+        }
+    }
+}
+
 // check if the given edge is in the graph
 bool AdjacencyList::has_edge(int v1, int v2) const
 {
@@ -170,6 +314,12 @@ bool AdjacencyList::has_edge(int v1, int v2) const
     {
         return false;
     }
+    // use the index if there is one
+    if (indexed)
+    {
+        return is_in_bounds_list(v1, number_of_vertices) &&
+            edge_index.count(edge_key(v1, v2)) > 0;
+    }
     // only one array needs to be checked
     // check adj in
     Node* inPtr = adj_list_in[v2];
@@ -193,6 +343,21 @@ bool AdjacencyList::get_edge(int v1, int v2, int& edge) const
     {
         return false;
     }
+    // use the index if there is one
+    if (indexed)
+    {
+        if (!is_in_bounds_list(v1, number_of_vertices))
+        {
+            return false;
+        }
+        unordered_map<long, EdgeNodes>::const_iterator it = edge_index.find(edge_key(v1, v2));
+        if (it == edge_index.end())
+        {
+            return false;
+        }
+        edge = it -> second.in -> edge;
+        return true;
+    }
     // only one array needs to be checked
     // check adj in
     Node* inPtr = adj_list_in[v2];
@@ -226,7 +391,7 @@ void AdjacencyList::remove_edge(int v1, int v2)
         delptr = adj_list_out[v1];
         adj_list_out[v1] = adj_list_out[v1] -> next;
         edgeRemoved = true;
-        delete delptr;
+        delete_node(delptr);
     }
     else {
         Node* currPtr = adj_list_out[v1];
@@ -239,7 +404,7 @@ void AdjacencyList::remove_edge(int v1, int v2)
                 currPtr -> next = currPtr -> next -> next;
                 edgeRemoved = true;
                 // delete the Node from the list
-                delete delptr;
+                delete_node(delptr);
                 break;
             }
             // increment the pointer
@@ -256,7 +421,7 @@ void AdjacencyList::remove_edge(int v1, int v2)
     {
         delptr = adj_list_in[v2];
         adj_list_in[v2] = adj_list_in[v2] -> next;
-        delete delptr;
+        delete_node(delptr);
     }
     else {
         Node* currPtr = adj_list_in[v2];
@@ -268,7 +433,7 @@ void AdjacencyList::remove_edge(int v1, int v2)
                 // assign the last Node's next to the deleted Node's next
                 currPtr -> next = currPtr -> next -> next;
                 // delete the Node from the list
-                delete delptr;
+                delete_node(delptr);
                 break;
             }
             // increment the pointer
@@ -277,7 +442,14 @@ void AdjacencyList::remove_edge(int v1, int v2)
     }
     // check if the edge was removed
     if (edgeRemoved)
+    {
         number_of_edges--;
+        if (indexed)
+        {
+            edge_index.erase(edge_key(v1, v2));
+        }
+        notify_edge_removed(v1, v2);
+    }
 }
   
 // get all vertices on an outgoing edge from given vertex
@@ -322,6 +494,40 @@ void AdjacencyList::adjacent(int v, std::list<int>& vertices) const
     connected_from(v, vertices);
 }
 
+// visit each outgoing edge of the given vertex
+bool AdjacencyList::visit_connected_to(int v1, EdgeVisitor& visitor) const
+{
+    // check if vertex is out of bounds
+    if(!is_in_bounds_list(v1, number_of_vertices))
+    {
+        return true;
+    }
+    // walk the adj out list
+    for (Node* outPtr = adj_list_out[v1]; outPtr != nullptr; outPtr = outPtr -> next)
+    {
+        if (!visitor.visit(outPtr -> vertex, outPtr -> edge))
+            return false;
+    }
+    return true;
+}
+
+// visit each incoming edge of the given vertex
+bool AdjacencyList::visit_connected_from(int v2, EdgeVisitor& visitor) const
+{
+    // check if vertex is out of bounds
+    if(!is_in_bounds_list(v2, number_of_vertices))
+    {
+        return true;
+    }
+    // walk the adj in list
+    for (Node* inPtr = adj_list_in[v2]; inPtr != nullptr; inPtr = inPtr -> next)
+    {
+        if (!visitor.visit(inPtr -> vertex, inPtr -> edge))
+            return false;
+    }
+    return true;
+}
+
 // get number of nodes in the graph
 int AdjacencyList::vertex_count() const
 {
@@ -334,27 +540,107 @@ int AdjacencyList::edge_count() const
     return number_of_edges;
 }
 
-// helper function to delete adj_list
-void AdjacencyList::make_empty()
+// turn the hash index of edges on or off
+void AdjacencyList::set_edge_index(bool enabled)
+{
+    if (enabled && !indexed)
+    {
+        build_edge_index();
+    }
+    else if (!enabled)
+    {
+        edge_index.clear();
+    }
+    indexed = enabled;
+}
+
+// check if the hash index of edges is on
+bool AdjacencyList::has_edge_index() const
+{
+    return indexed;
+}
+
+// return the edge_index key for edge v1->v2
+long AdjacencyList::edge_key(int v1, int v2) const
+{
+    return (long) v1 * number_of_vertices + v2;
+}
+
+// helper function to fill edge_index from the lists
+void AdjacencyList::build_edge_index()
 {
-    for(int i = 0; i < number_of_vertices; ++i)
+    edge_index.clear();
+    edge_index.reserve(number_of_edges);
+
+    // record the out node of each edge
+    for (int v1 = 0; v1 < number_of_vertices; ++v1)
     {
-        Node* delPtr = adj_list_out[i];
-        while(delPtr != nullptr)
+        for (Node* outPtr = adj_list_out[v1]; outPtr != nullptr; outPtr = outPtr -> next)
         {
-            Node* tempPtr = delPtr -> next;
-            delete delPtr;
-            delPtr = tempPtr;
+            edge_index[edge_key(v1, outPtr -> vertex)].out = outPtr;
         }
-        // delete all nodes from in list
-        delPtr = adj_list_in[i];
-        while(delPtr != nullptr)
+    }
+    // and then the matching in node
+    for (int v2 = 0; v2 < number_of_vertices; ++v2)
+    {
+        for (Node* inPtr = adj_list_in[v2]; inPtr != nullptr; inPtr = inPtr -> next)
         {
-            Node* tempPtr = delPtr -> next;
-            delete delPtr;
-            delPtr = tempPtr;
+            edge_index[edge_key(inPtr -> vertex, v2)].in = inPtr;
         }
     }
+}
+
+// helper function to delete adj_list
+void AdjacencyList::make_empty()
+{
+    // every node lives in a block, so the lists do not need to be walked
+    for (Node* block : node_blocks)
+    {
+        delete[] block;
+    }
+    node_blocks.clear();
+    block_size = 0;
+    block_used = 0;
+    free_nodes = nullptr;
+
     delete[] adj_list_in;
     delete[] adj_list_out;
-}
\ No newline at end of file
+    edge_index.clear();
+}
+
+// helper function to get an unused node from the free list or the
+// current block
+AdjacencyList::Node* AdjacencyList::new_node()
+{
+    if (free_nodes != nullptr)
+    {
+        Node* node = free_nodes;
+        free_nodes = free_nodes -> next;
+        return node;
+    }
+    if (block_used == block_size)
+    {
+        reserve_nodes(MIN_BLOCK_SIZE);
+    }
+    return &node_blocks.back()[block_used++];
+}
+
+// helper function to return a node to the free list
+void AdjacencyList::delete_node(Node* node)
+{
+    node -> next = free_nodes;
+    free_nodes = node;
+}
+
+// helper function to start a new block if the current one has fewer
+// than count unused nodes
+void AdjacencyList::reserve_nodes(int count)
+{
+    if (block_size - block_used >= count)
+    {
+        return;
+    }
+    block_size = count > MIN_BLOCK_SIZE ? count : MIN_BLOCK_SIZE;
+    block_used = 0;
+    node_blocks.push_back(new Node[block_size]);
+}
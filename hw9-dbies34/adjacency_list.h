@@ -30,6 +30,10 @@ public:
   // add or update an edge between existing vertices in the graph
   void set_edge(int v1, int edge_label, int v2);
 
+  // add or update each (v1, edge_label, v2) edge in the batch, linking
+  // the new edges into the lists in parallel
+  void set_edges(const Edges& edges);
+
   // check if the given edge is in the graph
   bool has_edge(int v1, int v2) const;  
 
@@ -55,6 +59,20 @@ public:
 
   // get number of edges in the graph
   int edge_count() const; 
+
+  // turn the hash index of edges on or off, where the index makes
+  // has_edge, get_edge, and set_edge constant time instead of a scan
+  // of the in list of v2 (off by default)
+  void set_edge_index(bool enabled);
+
+  // check if the hash index of edges is on
+  bool has_edge_index() const;
+
+  // visit each outgoing edge of the given vertex
+  bool visit_connected_to(int v1, EdgeVisitor& visitor) const;
+
+  // visit each incoming edge of the given vertex
+  bool visit_connected_from(int v2, EdgeVisitor& visitor) const;
   
 private:
 
@@ -71,7 +89,43 @@ private:
   Node** adj_list_out;
   // linked-list array of in edges (for connected_from)
   Node** adj_list_in;
+
+  // the out list and in list nodes of an edge
+  struct EdgeNodes {
+    Node* out;
+    Node* in;
+  };
+
+  // true if edge_index is kept up to date
+  bool indexed;
+  // hash index from edge v1->v2 (keyed by v1 * n + v2) to its nodes
+  std::unordered_map<long, EdgeNodes> edge_index;
+
+  // return the edge_index key for edge v1->v2
+  long edge_key(int v1, int v2) const;
+
+  // helper function to fill edge_index from the lists
+  void build_edge_index();
   
+  // nodes are handed out from large blocks, and removed nodes are kept
+  // on a free list (linked through next) for reuse
+  static const int MIN_BLOCK_SIZE = 1024;
+  std::vector<Node*> node_blocks;
+  int block_size;
+  int block_used;
+  Node* free_nodes;
+
+  // helper function to get an unused node from the free list or the
+  // current block
+  Node* new_node();
+
+  // helper function to return a node to the free list
+  void delete_node(Node* node);
+
+  // helper function to start a new block if the current one has fewer
+  // than count unused nodes
+  void reserve_nodes(int count);
+
   // helper function to delete adj_list
   void make_empty();
 
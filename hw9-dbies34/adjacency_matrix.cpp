@@ -34,14 +34,16 @@ AdjacencyMatrix::AdjacencyMatrix(int vertex_count)
     
     number_of_edges = 0;
 
-    // create array
-    int size = number_of_vertices * number_of_vertices;
-    adj_matrix = new int*[size];
+    // create the label array (every label 0) and the edge bitmap
+    long size = (long) number_of_vertices * number_of_vertices;
+    long words = (size + 63) / 64;
+    adj_matrix = new int[size]();
+    edge_bits = new uint64_t[words];
 
-    // initialize array
-    for (int i = 0; i < size; ++i)
+    // initialize the bitmap
+    for (long i = 0; i < words; ++i)
     {
-        adj_matrix[i] = nullptr;
+        edge_bits[i] = 0;
     }
 }
 
@@ -56,6 +58,8 @@ AdjacencyMatrix::AdjacencyMatrix(const AdjacencyMatrix& rhs)
 {
     number_of_vertices = 0;
     number_of_edges = 0;
+    adj_matrix = nullptr;
+    edge_bits = nullptr;
 
     // call assignment operator
     *this = rhs;
@@ -67,21 +71,28 @@ AdjacencyMatrix& AdjacencyMatrix::operator=(const AdjacencyMatrix& rhs)
     if(&rhs != this)
     {
         // free memory
-        //make_empty(); // causes double free error
+        make_empty();
 
         number_of_vertices = rhs.number_of_vertices;
         number_of_edges = rhs.number_of_edges;
 
-        int size = number_of_vertices * number_of_vertices;
+        long size = (long) number_of_vertices * number_of_vertices;
+        long words = (size + 63) / 64;
 
-        // create new array
-        adj_matrix = new int*[size];
+        // create new arrays
+        adj_matrix = new int[size];
+        edge_bits = new uint64_t[words];
 
-        // copy array
-        for (int i = 0; i < size; ++i)
+        // copy arrays
+        for (long i = 0; i < size; ++i)
         {
             adj_matrix[i] = rhs.adj_matrix[i];
         }
+        for (long i = 0; i < words; ++i)
+        {
+            edge_bits[i] = rhs.edge_bits[i];
+        }
+        notify_graph_assigned();
     }
     return *this;
 }
@@ -94,12 +105,22 @@ void AdjacencyMatrix::set_edge(int v1, int edge_label, int v2)
     {
         return;
     }
-    // increment if edge does not exist
-    if(!has_edge(v1, v2))
+    long i = index(v1, v2);
+    // increment and mark the cell if edge does not exist
+    if(!is_edge(i))
     {
+        // a listener may keep the new edge out
+        if (!allow_new_edge(v1, v2))
+        {
+            return;
+        }
+        edge_bits[i / 64] |= (uint64_t) 1 << (i % 64);
         number_of_edges++;
+        adj_matrix[i] = edge_label;
+        notify_edge_added(v1, v2);
+        return;
     }
-    adj_matrix[index(v1, v2)] = new int(edge_label);
+    adj_matrix[i] = edge_label;
 }
 
 // check if the given edge is in the graph
@@ -110,7 +131,7 @@ bool AdjacencyMatrix::has_edge(int v1, int v2) const
     {
         return false;
     } else {
-        return adj_matrix[index(v1, v2)] != nullptr;
+        return is_edge(index(v1, v2));
     }
 }
 
@@ -120,7 +141,7 @@ bool AdjacencyMatrix::get_edge(int v1, int v2, int& edge) const
 {
     if (has_edge(v1, v2))
     {
-        edge = *adj_matrix[index(v1, v2)];
+        edge = adj_matrix[index(v1, v2)];
         return true;
     }
     else{
@@ -135,8 +156,10 @@ void AdjacencyMatrix::remove_edge(int v1, int v2)
     if (has_edge(v1, v2))
     {
         // remove the edge from the matrix
-        adj_matrix[index(v1, v2)] = nullptr;
+        long i = index(v1, v2);
+        edge_bits[i / 64] &= ~((uint64_t) 1 << (i % 64));
         number_of_edges--;
+        notify_edge_removed(v1, v2);
     }
 }
   
@@ -149,12 +172,12 @@ void AdjacencyMatrix::connected_to(int v1, std::list<int>& vertices) const
         return;
     }
     // index through the row
-    int startIndex = v1 * number_of_vertices;
-    for(int i = startIndex; i < startIndex + number_of_vertices; ++i)
+    long startIndex = index(v1, 0);
+    for(int v2 = 0; v2 < number_of_vertices; ++v2)
     {
-        if(adj_matrix[i] != nullptr)
+        if(is_edge(startIndex + v2))
         {
-            vertices.push_front(i - number_of_vertices * v1);
+            vertices.push_front(v2);
         }
     }
 }
@@ -168,11 +191,11 @@ void AdjacencyMatrix::connected_from(int v2, std::list<int>& vertices) const
         return;
     }
     // index down the column
-    for(int i = v2; i < number_of_vertices * number_of_vertices; i += number_of_vertices)
+    for(int v1 = 0; v1 < number_of_vertices; ++v1)
     {
-        if(adj_matrix[i] != nullptr)
+        if(is_edge(index(v1, v2)))
         {
-            vertices.push_front(i / number_of_vertices);
+            vertices.push_front(v1);
         }
     }
 }
@@ -185,6 +208,47 @@ void AdjacencyMatrix::adjacent(int v, std::list<int>& vertices) const
     connected_from(v, vertices);
 }
 
+// visit each outgoing edge of the given vertex
+bool AdjacencyMatrix::visit_connected_to(int v1, EdgeVisitor& visitor) const
+{
+    // check if the vertex is in bounds
+    if(!is_in_bounds_matrix(v1, number_of_vertices))
+    {
+        return true;
+    }
+    // index through the row
+    long startIndex = index(v1, 0);
+    for(int v2 = 0; v2 < number_of_vertices; ++v2)
+    {
+        long i = startIndex + v2;
+        if(is_edge(i) && !visitor.visit(v2, adj_matrix[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// visit each incoming edge of the given vertex
+bool AdjacencyMatrix::visit_connected_from(int v2, EdgeVisitor& visitor) const
+{
+    // check if the vertex is in bounds
+    if(!is_in_bounds_matrix(v2, number_of_vertices))
+    {
+        return true;
+    }
+    // index down the column
+    for(int v1 = 0; v1 < number_of_vertices; ++v1)
+    {
+        long i = index(v1, v2);
+        if(is_edge(i) && !visitor.visit(v1, adj_matrix[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 // get number of nodes in the graph
 int AdjacencyMatrix::vertex_count() const
 {
@@ -198,20 +262,20 @@ int AdjacencyMatrix::edge_count() const
 }
 
 // return the matrix index for edge x->y
-int AdjacencyMatrix::index(int x, int y) const
+long AdjacencyMatrix::index(int x, int y) const
+{
+    return ((long) x * number_of_vertices) + y;
+}
+
+// check if the cell at the given matrix index holds an edge
+bool AdjacencyMatrix::is_edge(long i) const
 {
-    return (x * number_of_vertices) + y;
+    return (edge_bits[i / 64] >> (i % 64)) & 1;
 }
 
 // delete the adjacency matrix
 void AdjacencyMatrix::make_empty()
 {
-    for (int i = 0; i < vertex_count() * vertex_count(); i++)
-    {
-        if (adj_matrix[i] != nullptr)
-        {
-            delete adj_matrix[i];
-        }
-    }
     delete[] adj_matrix;
+    delete[] edge_bits;
 }
@@ -9,6 +9,7 @@
 #define ADJACENCY_MATRIX_H
 
 #include "graph.h"
+#include <cstdint>
 
 
 class AdjacencyMatrix : public Graph
@@ -55,17 +56,29 @@ public:
 
   // get number of edges in the graph
   int edge_count() const; 
+
+  // visit each outgoing edge of the given vertex
+  bool visit_connected_to(int v1, EdgeVisitor& visitor) const;
+
+  // visit each incoming edge of the given vertex
+  bool visit_connected_from(int v2, EdgeVisitor& visitor) const;
   
 private:
 
   int number_of_vertices;
   int number_of_edges;
 
-  // an array of pointers to int
-  int** adj_matrix; 
+  // edge labels stored row by row in a single array
+  int* adj_matrix;
+
+  // bitmap marking which cells of adj_matrix hold an edge
+  uint64_t* edge_bits;
 
   // return the matrix index for edge x->y
-  int index(int x, int y) const;
+  long index(int x, int y) const;
+
+  // check if the cell at the given matrix index holds an edge
+  bool is_edge(long i) const;
 
   // delete the adjacency matrix
   void make_empty();
@@ -0,0 +1,110 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: bipartite_index.cpp
+// DATE: Spring 2021
+// DESC: Bipartiteness of a graph kept up to date as edges are added,
+// so that each new edge can be checked without a new search
+//----------------------------------------------------------------------
+
+#include "bipartite_index.h"
+
+using namespace std;
+
+// build the index and follow the graph
+BipartiteIndex::BipartiteIndex(Graph& graph)
+    : graph(graph), sets(graph.vertex_count())
+{
+    rebuild();
+    graph.add_listener(this);
+}
+
+// stop following the graph
+BipartiteIndex::~BipartiteIndex()
+{
+    graph.remove_listener(this);
+}
+
+// check if the graph is bipartite
+bool BipartiteIndex::bipartite()
+{
+    refresh();
+    return is_bipartite;
+}
+
+// the side of v
+int BipartiteIndex::side(int v)
+{
+    refresh();
+    // check if out of bounds
+    if (v < 0 || v >= sets.size())
+    {
+        return -1;
+    }
+    int parity;
+    sets.find(v, parity);
+    return parity;
+}
+
+// place the ends of a new edge on different sides
+void BipartiteIndex::edge_added(int v1, int v2)
+{
+    // a stale index is rebuilt with the edge later, and once the graph
+    // is not bipartite only a removal can change that
+    if (stale || !is_bipartite)
+    {
+        return;
+    }
+    // an edge the sets have no room for means the graph changed size
+    if (v1 < 0 || v2 < 0 || v1 >= sets.size() || v2 >= sets.size())
+    {
+        stale = true;
+        return;
+    }
+    if (!sets.join(v1, v2, true))
+    {
+        is_bipartite = false;
+    }
+}
+
+// mark the index to be rebuilt
+void BipartiteIndex::edge_removed(int, int)
+{
+    stale = true;
+}
+
+// mark the index to be rebuilt
+void BipartiteIndex::graph_assigned()
+{
+    stale = true;
+}
+
+// rebuild the index from the edges of the graph
+void BipartiteIndex::rebuild()
+{
+    if (sets.size() != graph.vertex_count())
+    {
+        sets = ParityUnionFind(graph.vertex_count());
+    }
+    else
+    {
+        sets.reset();
+    }
+    is_bipartite = true;
+    stale = false;
+    for (int u = 0; u < graph.vertex_count() && is_bipartite; ++u)
+    {
+        graph.any_connected_to(u, [&](int v, int) {
+            is_bipartite = sets.join(u, v, true);
+            return !is_bipartite;
+        });
+    }
+}
+
+// rebuild the index if it is stale
+void BipartiteIndex::refresh()
+{
+    if (stale)
+    {
+        rebuild();
+    }
+}
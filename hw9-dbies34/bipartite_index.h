@@ -0,0 +1,74 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: bipartite_index.h
+// DATE: Spring 2021
+// DESC: Bipartiteness of a graph kept up to date as edges are added,
+// so that each new edge can be checked without a new search
+//----------------------------------------------------------------------
+
+#ifndef BIPARTITE_INDEX_H
+#define BIPARTITE_INDEX_H
+
+#include "graph.h"
+#include "union_find.h"
+
+
+class BipartiteIndex : public EdgeListener
+{
+public:
+
+  // build the index from the current edges of the graph and follow
+  // its edge changes until the index is destroyed
+  BipartiteIndex(Graph& graph);
+
+  // stop following the graph
+  ~BipartiteIndex();
+
+  // the index follows a single graph, so it is not copied
+  BipartiteIndex(const BipartiteIndex& rhs) = delete;
+  BipartiteIndex& operator=(const BipartiteIndex& rhs) = delete;
+
+  // check if the graph is bipartite (ignoring edge direction)
+  bool bipartite();
+
+  // the side (0 or 1) of v, where the two ends of each edge are on
+  // different sides if the graph is bipartite (-1 if out of bounds).
+  // Sides may change after the next edge change.
+  int side(int v);
+
+  // place the ends of a new edge on different sides, which fails if
+  // they are already on the same side
+  void edge_added(int v1, int v2);
+
+  // sides cannot be split in place, so a removed edge marks the index
+  // to be rebuilt on the next query
+  void edge_removed(int v1, int v2);
+
+  // mark the index to be rebuilt on the next query
+  void graph_assigned();
+
+  // rebuild the index from the edges of the graph
+  void rebuild();
+
+private:
+
+  Graph& graph;
+
+  // the components, where the elements of each set are split into
+  // the two sides
+  ParityUnionFind sets;
+
+  // false once an edge joins two vertices on the same side
+  bool is_bipartite;
+
+  // true if an edge was removed or the graph was assigned to since
+  // the last rebuild
+  bool stale;
+
+  // rebuild the index if it is stale
+  void refresh();
+
+};
+
+
+#endif
@@ -0,0 +1,351 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: bit_adjacency_matrix.cpp
+// DATE: Spring 2021
+// DESC: Bit-packed adjacency matrix implementation of the graph
+// interface
+//----------------------------------------------------------------------
+
+#include "bit_adjacency_matrix.h"
+
+using namespace std;
+
+// checks if the vertices is in bounds
+static bool is_in_bounds_bits(int v1, int v2, int vertex_count)
+{
+    return v2 < vertex_count && v1 < vertex_count && v1 >= 0 && v2 >= 0;
+}
+
+// checks if the vertex is in bounds
+static bool is_in_bounds_bits(int v1, int vertex_count)
+{
+    return v1 < vertex_count && v1 >= 0;
+}
+
+// visit the vertex of each set bit in the row, lowest first, returns
+// false if the visitor stopped early
+static bool visit_row(const uint64_t* row, int words,
+                      const unordered_map<long, int>& labels,
+                      long first_index, long stride, EdgeVisitor& visitor)
+{
+    for (int w = 0; w < words; ++w)
+    {
+        uint64_t bits = row[w];
+        while (bits != 0)
+        {
+            // take the lowest set bit and clear it
+            int v = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+
+            int label = 0;
+            if (!labels.empty())
+            {
+                auto found = labels.find(first_index + v * stride);
+                if (found != labels.end())
+                    label = found->second;
+            }
+            if (!visitor.visit(v, label))
+                return false;
+        }
+    }
+    return true;
+}
+
+// default constructor
+BitAdjacencyMatrix::BitAdjacencyMatrix(int vertex_count)
+{
+    // check for negative vertex count
+    if (vertex_count < 0)
+    {
+        number_of_vertices = 0;
+    } else {
+        number_of_vertices = vertex_count;
+    }
+
+    number_of_edges = 0;
+    words_per_row = (number_of_vertices + 63) / 64;
+
+    // create the rows with no edges
+    long size = (long) number_of_vertices * words_per_row;
+    out_bits = new uint64_t[size];
+    in_bits = new uint64_t[size];
+    for (long i = 0; i < size; ++i)
+    {
+        out_bits[i] = 0;
+        in_bits[i] = 0;
+    }
+}
+
+// destructor
+BitAdjacencyMatrix::~BitAdjacencyMatrix()
+{
+    make_empty();
+}
+
+// copy constructor
+BitAdjacencyMatrix::BitAdjacencyMatrix(const BitAdjacencyMatrix& rhs)
+{
+    number_of_vertices = 0;
+    number_of_edges = 0;
+    words_per_row = 0;
+    out_bits = nullptr;
+    in_bits = nullptr;
+
+    // call assignment operator
+    *this = rhs;
+}
+
+// assignment operator
+BitAdjacencyMatrix& BitAdjacencyMatrix::operator=(const BitAdjacencyMatrix& rhs)
+{
+    if (&rhs != this)
+    {
+        // free memory
+        make_empty();
+
+        number_of_vertices = rhs.number_of_vertices;
+        number_of_edges = rhs.number_of_edges;
+        words_per_row = rhs.words_per_row;
+
+        // copy the rows
+        long size = (long) number_of_vertices * words_per_row;
+        out_bits = new uint64_t[size];
+        in_bits = new uint64_t[size];
+        for (long i = 0; i < size; ++i)
+        {
+            out_bits[i] = rhs.out_bits[i];
+            in_bits[i] = rhs.in_bits[i];
+        }
+
+        // copy the labels
+        labels = rhs.labels;
+        notify_graph_assigned();
+    }
+    return *this;
+}
+
+// add or update an edge between existing vertices in the graph
+void BitAdjacencyMatrix::set_edge(int v1, int edge_label, int v2)
+{
+    // check if out of bounds
+    if (!is_in_bounds_bits(v1, v2, number_of_vertices))
+    {
+        return;
+    }
+    // set the bit in both rows if the edge does not exist (and a
+    // listener does not keep it out)
+    bool isNew = !has_edge(v1, v2);
+    if (isNew && !allow_new_edge(v1, v2))
+    {
+        return;
+    }
+    if (isNew)
+    {
+        out_bits[(long) v1 * words_per_row + v2 / 64] |= (uint64_t) 1 << (v2 % 64);
+        in_bits[(long) v2 * words_per_row + v1 / 64] |= (uint64_t) 1 << (v1 % 64);
+        number_of_edges++;
+    }
+    // only non-zero labels are stored
+    if (edge_label != 0)
+    {
+        labels[index(v1, v2)] = edge_label;
+    } else {
+        labels.erase(index(v1, v2));
+    }
+    if (isNew)
+    {
+        notify_edge_added(v1, v2);
+    }
+}
+
+// check if the given edge is in the graph
+bool BitAdjacencyMatrix::has_edge(int v1, int v2) const
+{
+    // first check if out of bounds
+    if (!is_in_bounds_bits(v1, v2, number_of_vertices))
+    {
+        return false;
+    }
+    return (out_bits[(long) v1 * words_per_row + v2 / 64] >> (v2 % 64)) & 1;
+}
+
+// returns true if there is an edge between v1 and v2 in the graph
+// the output parameter returns the edge label
+bool BitAdjacencyMatrix::get_edge(int v1, int v2, int& edge) const
+{
+    if (!has_edge(v1, v2))
+    {
+        return false;
+    }
+    auto found = labels.find(index(v1, v2));
+    edge = found == labels.end() ? 0 : found->second;
+    return true;
+}
+
+// remove the edge between the two vertices
+void BitAdjacencyMatrix::remove_edge(int v1, int v2)
+{
+    // check if the edge exists
+    if (has_edge(v1, v2))
+    {
+        out_bits[(long) v1 * words_per_row + v2 / 64] &= ~((uint64_t) 1 << (v2 % 64));
+        in_bits[(long) v2 * words_per_row + v1 / 64] &= ~((uint64_t) 1 << (v1 % 64));
+        labels.erase(index(v1, v2));
+        number_of_edges--;
+        notify_edge_removed(v1, v2);
+    }
+}
+
+// get all vertices on an outgoing edge from given vertex
+void BitAdjacencyMatrix::connected_to(int v1, std::list<int>& vertices) const
+{
+    for_each_connected_to(v1, [&](int v2, int) { vertices.push_back(v2); });
+}
+
+// get all vertices on an incoming edge to given vertex
+void BitAdjacencyMatrix::connected_from(int v2, std::list<int>& vertices) const
+{
+    for_each_connected_from(v2, [&](int v1, int) { vertices.push_back(v1); });
+}
+
+// get all vertices adjacent to a vertex, that is, connected to or connected
+// from the vertex (may return duplicate vertices)
+void BitAdjacencyMatrix::adjacent(int v, std::list<int>& vertices) const
+{
+    connected_to(v, vertices);
+    connected_from(v, vertices);
+}
+
+// get number of nodes in the graph
+int BitAdjacencyMatrix::vertex_count() const
+{
+    return number_of_vertices;
+}
+
+// get number of edges in the graph
+int BitAdjacencyMatrix::edge_count() const
+{
+    return number_of_edges;
+}
+
+// visit each outgoing edge of the given vertex
+bool BitAdjacencyMatrix::visit_connected_to(int v1, EdgeVisitor& visitor) const
+{
+    // check if the vertex is in bounds
+    if (!is_in_bounds_bits(v1, number_of_vertices))
+    {
+        return true;
+    }
+    // labels of the row are at index(v1, 0) + v2
+    return visit_row(out_row(v1), words_per_row, labels, index(v1, 0), 1, visitor);
+}
+
+// visit each incoming edge of the given vertex
+bool BitAdjacencyMatrix::visit_connected_from(int v2, EdgeVisitor& visitor) const
+{
+    // check if the vertex is in bounds
+    if (!is_in_bounds_bits(v2, number_of_vertices))
+    {
+        return true;
+    }
+    // labels of the column are at index(0, v2) + v1 * n
+    return visit_row(in_row(v2), words_per_row, labels, index(0, v2), number_of_vertices, visitor);
+}
+
+// number of 64-bit words in each row
+int BitAdjacencyMatrix::row_words() const
+{
+    return words_per_row;
+}
+
+// the packed out edges of the given vertex
+const uint64_t* BitAdjacencyMatrix::out_row(int v1) const
+{
+    return out_bits + (long) v1 * words_per_row;
+}
+
+// the packed in edges of the given vertex
+const uint64_t* BitAdjacencyMatrix::in_row(int v2) const
+{
+    return in_bits + (long) v2 * words_per_row;
+}
+
+// result = out_row(v1) & out_row(v2)
+void BitAdjacencyMatrix::out_row_and(int v1, int v2, uint64_t* result) const
+{
+    const uint64_t* row1 = out_row(v1);
+    const uint64_t* row2 = out_row(v2);
+    for (int w = 0; w < words_per_row; ++w)
+    {
+        result[w] = row1[w] & row2[w];
+    }
+}
+
+// result |= out_row(v1)
+void BitAdjacencyMatrix::out_row_or(int v1, uint64_t* result) const
+{
+    const uint64_t* row = out_row(v1);
+    for (int w = 0; w < words_per_row; ++w)
+    {
+        result[w] |= row[w];
+    }
+}
+
+// number of vertices on an outgoing edge from both v1 and v2
+int BitAdjacencyMatrix::common_out_count(int v1, int v2) const
+{
+    const uint64_t* row1 = out_row(v1);
+    const uint64_t* row2 = out_row(v2);
+    int count = 0;
+    for (int w = 0; w < words_per_row; ++w)
+    {
+        count += __builtin_popcountll(row1[w] & row2[w]);
+    }
+    return count;
+}
+
+// add an edge v1->v2 for each bit v2 set in row
+void BitAdjacencyMatrix::add_out_row(int v1, const uint64_t* row)
+{
+    // check if out of bounds
+    if (!is_in_bounds_bits(v1, number_of_vertices))
+    {
+        return;
+    }
+    uint64_t* out = out_bits + (long) v1 * words_per_row;
+    for (int w = 0; w < words_per_row; ++w)
+    {
+        // only the bits of edges not yet in the graph
+        uint64_t bits = row[w] & ~out[w];
+        if (w == words_per_row - 1 && number_of_vertices % 64 != 0)
+        {
+            bits &= ((uint64_t) 1 << (number_of_vertices % 64)) - 1;
+        }
+        while (bits != 0)
+        {
+            int v2 = w * 64 + __builtin_ctzll(bits);
+            bits &= bits - 1;
+            if (!listeners.empty() && !allow_new_edge(v1, v2))
+            {
+                continue;
+            }
+            out[w] |= (uint64_t) 1 << (v2 % 64);
+            in_bits[(long) v2 * words_per_row + v1 / 64] |= (uint64_t) 1 << (v1 % 64);
+            number_of_edges++;
+            notify_edge_added(v1, v2);
+        }
+    }
+}
+
+// return the matrix index for edge x->y
+long BitAdjacencyMatrix::index(int x, int y) const
+{
+    return ((long) x * number_of_vertices) + y;
+}
+
+// delete the bit rows
+void BitAdjacencyMatrix::make_empty()
+{
+    delete[] out_bits;
+    delete[] in_bits;
+}
@@ -0,0 +1,123 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: bit_adjacency_matrix.h
+// DATE: Spring 2021
+// DESC: Bit-packed adjacency matrix implementation of the graph
+// interface. Each vertex has a row of 64-bit words marking its out
+// edges and a transposed row marking its in edges, so that rows can
+// be combined 64 vertices at a time. Labels are kept apart from the
+// bits in a hash map holding only the non-zero labels, so unlabelled
+// edges take a bit each, but each labelled edge takes a map entry and
+// visiting the edges of a labelled graph looks up each edge.
+//----------------------------------------------------------------------
+
+#ifndef BIT_ADJACENCY_MATRIX_H
+#define BIT_ADJACENCY_MATRIX_H
+
+#include "graph.h"
+#include <cstdint>
+#include <unordered_map>
+
+
+class BitAdjacencyMatrix : public Graph
+{
+public:
+
+  // default constructor
+  BitAdjacencyMatrix(int vertex_count);
+
+  // destructor
+  ~BitAdjacencyMatrix();
+
+  // copy constructor
+  BitAdjacencyMatrix(const BitAdjacencyMatrix& rhs);
+
+  // assignment operator
+  BitAdjacencyMatrix& operator=(const BitAdjacencyMatrix& rhs);
+
+  // add or update an edge between existing vertices in the graph
+  void set_edge(int v1, int edge_label, int v2);
+
+  // check if the given edge is in the graph
+  bool has_edge(int v1, int v2) const;
+
+  // returns true if there is an edge between v1 and v2 in the graph
+  // the output parameter returns the edge label
+  bool get_edge(int v1, int v2, int& edge) const;
+
+  // remove the edge between the two vertices
+  void remove_edge(int v1, int v2);
+
+  // get all vertices on an outgoing edge from given vertex
+  void connected_to(int v1, std::list<int>& vertices) const;
+
+  // get all vertices on an incoming edge to given vertex
+  void connected_from(int v2, std::list<int>& vertices) const;
+
+  // get all vertices adjacent to a vertex, that is, connected to or connected
+  // from the vertex (may return duplicate vertices)
+  void adjacent(int v, std::list<int>& vertices) const;
+
+  // get number of nodes in the graph
+  int vertex_count() const;
+
+  // get number of edges in the graph
+  int edge_count() const;
+
+  // visit each outgoing edge of the given vertex
+  bool visit_connected_to(int v1, EdgeVisitor& visitor) const;
+
+  // visit each incoming edge of the given vertex
+  bool visit_connected_from(int v2, EdgeVisitor& visitor) const;
+
+  // number of 64-bit words in each row
+  int row_words() const;
+
+  // the packed out edges of the given vertex (bit v2 is set for each
+  // edge v1->v2)
+  const uint64_t* out_row(int v1) const;
+
+  // the packed in edges of the given vertex (bit v1 is set for each
+  // edge v1->v2)
+  const uint64_t* in_row(int v2) const;
+
+  // result = out_row(v1) & out_row(v2), where result has row_words()
+  // words
+  void out_row_and(int v1, int v2, uint64_t* result) const;
+
+  // result |= out_row(v1), where result has row_words() words
+  void out_row_or(int v1, uint64_t* result) const;
+
+  // number of vertices on an outgoing edge from both v1 and v2
+  int common_out_count(int v1, int v2) const;
+
+  // add an edge v1->v2 (with label 0) for each bit v2 set in row, where
+  // row has row_words() words, existing edges are left as is, and
+  // listeners may keep new edges out
+  void add_out_row(int v1, const uint64_t* row);
+
+private:
+
+  int number_of_vertices;
+  int number_of_edges;
+  int words_per_row;
+
+  // out rows followed one after another (for connected_to)
+  uint64_t* out_bits;
+  // in rows followed one after another (for connected_from)
+  uint64_t* in_bits;
+
+  // the non-zero edge labels by matrix index (edges not in the map
+  // have label 0)
+  std::unordered_map<long, int> labels;
+
+  // return the matrix index for edge x->y
+  long index(int x, int y) const;
+
+  // delete the bit rows
+  void make_empty();
+
+};
+
+
+#endif
@@ -0,0 +1,128 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: connectivity_index.cpp
+// DATE: Spring 2021
+// DESC: Connected components of a graph kept up to date as edges are
+// added, so that connectivity queries do not need a new search
+//----------------------------------------------------------------------
+
+#include "connectivity_index.h"
+
+using namespace std;
+
+// checks if the vertex is in bounds
+static bool is_in_bounds_index(int v, int vertex_count)
+{
+    return v < vertex_count && v >= 0;
+}
+
+// build the index and follow the graph
+ConnectivityIndex::ConnectivityIndex(Graph& graph)
+    : graph(graph), sets(graph.vertex_count())
+{
+    rebuild();
+    graph.add_listener(this);
+}
+
+// stop following the graph
+ConnectivityIndex::~ConnectivityIndex()
+{
+    graph.remove_listener(this);
+}
+
+// check if v1 and v2 are in the same component
+bool ConnectivityIndex::connected(int v1, int v2)
+{
+    refresh();
+    // check if out of bounds
+    if (!is_in_bounds_index(v1, sets.size()) || !is_in_bounds_index(v2, sets.size()))
+    {
+        return false;
+    }
+    return sets.same(v1, v2);
+}
+
+// id of the component holding v (-1 if out of bounds)
+int ConnectivityIndex::component(int v)
+{
+    refresh();
+    if (!is_in_bounds_index(v, sets.size()))
+    {
+        return -1;
+    }
+    return sets.find(v);
+}
+
+// number of connected components
+int ConnectivityIndex::component_count()
+{
+    refresh();
+    return sets.set_count();
+}
+
+// number of vertices in the component holding v (0 if out of bounds)
+int ConnectivityIndex::component_size(int v)
+{
+    refresh();
+    if (!is_in_bounds_index(v, sets.size()))
+    {
+        return 0;
+    }
+    return sets.set_size(v);
+}
+
+// join the components of a new edge
+void ConnectivityIndex::edge_added(int v1, int v2)
+{
+    // a stale index is rebuilt with the edge later
+    if (stale)
+    {
+        return;
+    }
+    // an edge the sets have no room for means the graph changed size
+    if (!is_in_bounds_index(v1, sets.size()) || !is_in_bounds_index(v2, sets.size()))
+    {
+        stale = true;
+        return;
+    }
+    sets.join(v1, v2);
+}
+
+// mark the index to be rebuilt
+void ConnectivityIndex::edge_removed(int, int)
+{
+    stale = true;
+}
+
+// mark the index to be rebuilt
+void ConnectivityIndex::graph_assigned()
+{
+    stale = true;
+}
+
+// rebuild the index from the edges of the graph
+void ConnectivityIndex::rebuild()
+{
+    if (sets.size() != graph.vertex_count())
+    {
+        sets = UnionFind(graph.vertex_count());
+    }
+    else
+    {
+        sets.reset();
+    }
+    for (int u = 0; u < graph.vertex_count(); ++u)
+    {
+        graph.for_each_connected_to(u, [&](int v, int) { sets.join(u, v); });
+    }
+    stale = false;
+}
+
+// rebuild the index if an edge was removed
+void ConnectivityIndex::refresh()
+{
+    if (stale)
+    {
+        rebuild();
+    }
+}
@@ -0,0 +1,73 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: connectivity_index.h
+// DATE: Spring 2021
+// DESC: Connected components of a graph kept up to date as edges are
+// added, so that connectivity queries do not need a new search
+//----------------------------------------------------------------------
+
+#ifndef CONNECTIVITY_INDEX_H
+#define CONNECTIVITY_INDEX_H
+
+#include "graph.h"
+#include "union_find.h"
+
+
+class ConnectivityIndex : public EdgeListener
+{
+public:
+
+  // build the index from the current edges of the graph and follow
+  // its edge changes until the index is destroyed
+  ConnectivityIndex(Graph& graph);
+
+  // stop following the graph
+  ~ConnectivityIndex();
+
+  // the index follows a single graph, so it is not copied
+  ConnectivityIndex(const ConnectivityIndex& rhs) = delete;
+  ConnectivityIndex& operator=(const ConnectivityIndex& rhs) = delete;
+
+  // check if v1 and v2 are in the same (weakly) connected component
+  bool connected(int v1, int v2);
+
+  // id of the component holding v, which is the same for each vertex
+  // of the component until the next edge change
+  int component(int v);
+
+  // number of connected components
+  int component_count();
+
+  // number of vertices in the component holding v
+  int component_size(int v);
+
+  // join the components of a new edge
+  void edge_added(int v1, int v2);
+
+  // components cannot be split in place, so a removed edge marks the
+  // index to be rebuilt on the next query
+  void edge_removed(int v1, int v2);
+
+  // mark the index to be rebuilt on the next query
+  void graph_assigned();
+
+  // rebuild the index from the edges of the graph
+  void rebuild();
+
+private:
+
+  Graph& graph;
+
+  // the components, where each set is a component
+  UnionFind sets;
+
+  // true if an edge was removed since the last rebuild
+  bool stale;
+
+  // rebuild the index if an edge was removed
+  void refresh();
+
+};
+
+
+#endif
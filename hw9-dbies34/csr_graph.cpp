@@ -0,0 +1,438 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: csr_graph.cpp
+// DATE: Spring 2021
+// DESC: Immutable compressed-sparse-row implementation of the graph
+// interface
+//----------------------------------------------------------------------
+
+#include "csr_graph.h"
+#include "parallel.h"
+#include <algorithm>
+#include <tuple>
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// checks if the vertices is in bounds
+static bool is_in_bounds_csr(int v1, int v2, int vertex_count)
+{
+    return v2 < vertex_count && v1 < vertex_count && v1 >= 0 && v2 >= 0;
+}
+
+// checks if the vertex is in bounds
+static bool is_in_bounds_csr(int v1, int vertex_count)
+{
+    return v1 < vertex_count && v1 >= 0;
+}
+
+// header at the start of a binary graph file
+struct CsrFileHeader
+{
+    char magic[8];
+    int32_t version;
+    int32_t vertex_count;
+    int64_t edge_count;
+};
+
+// checks that offsets start at 0, never decrease, and end at m, and
+// that each of the m vertices they index is in bounds
+static bool valid_csr_arrays(const int* offsets, const int* vertices, int n, int m)
+{
+    if (offsets[0] != 0 || offsets[n] != m)
+    {
+        return false;
+    }
+    for (int v = 0; v < n; ++v)
+    {
+        if (offsets[v + 1] < offsets[v])
+        {
+            return false;
+        }
+    }
+    for (int k = 0; k < m; ++k)
+    {
+        if (!is_in_bounds_csr(vertices[k], n))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const char CSR_FILE_MAGIC[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'};
+const int32_t CSR_FILE_VERSION = 1;
+
+// build the graph from a list of edges
+CsrGraph::CsrGraph(int vertex_count, const Edges& edges)
+{
+    mapped_file = nullptr;
+    mapped_size = 0;
+
+    // check for negative vertex count
+    if (vertex_count < 0)
+    {
+        number_of_vertices = 0;
+    } else {
+        number_of_vertices = vertex_count;
+    }
+
+    number_of_edges = 0;
+    build(edges);
+}
+
+// empty graph used by load
+CsrGraph::CsrGraph()
+{
+    number_of_vertices = 0;
+    number_of_edges = 0;
+    out_offsets = out_targets = out_labels = nullptr;
+    in_offsets = in_sources = in_labels = nullptr;
+    mapped_file = nullptr;
+    mapped_size = 0;
+}
+
+// destructor
+CsrGraph::~CsrGraph()
+{
+    make_empty();
+}
+
+// copy constructor
+CsrGraph::CsrGraph(const CsrGraph& rhs)
+{
+    // initialize the arrays
+    number_of_vertices = 0;
+    number_of_edges = 0;
+    out_offsets = out_targets = out_labels = nullptr;
+    in_offsets = in_sources = in_labels = nullptr;
+    mapped_file = nullptr;
+    mapped_size = 0;
+    // call assignment operator
+    *this = rhs;
+}
+
+// assignment operator
+CsrGraph& CsrGraph::operator=(const CsrGraph& rhs)
+{
+    if (&rhs != this)
+    {
+        // free memory
+        make_empty();
+
+        number_of_vertices = rhs.number_of_vertices;
+        number_of_edges = rhs.number_of_edges;
+
+        int n = number_of_vertices + 1;
+        int m = number_of_edges;
+        out_offsets = new int[n];
+        in_offsets = new int[n];
+        out_targets = new int[m];
+        out_labels = new int[m];
+        in_sources = new int[m];
+        in_labels = new int[m];
+
+        // copy arrays
+        copy(rhs.out_offsets, rhs.out_offsets + n, out_offsets);
+        copy(rhs.in_offsets, rhs.in_offsets + n, in_offsets);
+        copy(rhs.out_targets, rhs.out_targets + m, out_targets);
+        copy(rhs.out_labels, rhs.out_labels + m, out_labels);
+        copy(rhs.in_sources, rhs.in_sources + m, in_sources);
+        copy(rhs.in_labels, rhs.in_labels + m, in_labels);
+        notify_graph_assigned();
+    }
+    return *this;
+}
+
+// write the graph to the given file in the binary format
+bool CsrGraph::save(const std::string& filename) const
+{
+    ofstream f(filename, ios::binary);
+    if (!f)
+    {
+        return false;
+    }
+    CsrFileHeader header;
+    memcpy(header.magic, CSR_FILE_MAGIC, sizeof(header.magic));
+    header.version = CSR_FILE_VERSION;
+    header.vertex_count = number_of_vertices;
+    header.edge_count = number_of_edges;
+    f.write((const char*) &header, sizeof(header));
+
+    long n = (number_of_vertices + 1) * sizeof(int);
+    long m = number_of_edges * (long) sizeof(int);
+    f.write((const char*) out_offsets, n);
+    f.write((const char*) out_targets, m);
+    f.write((const char*) out_labels, m);
+    f.write((const char*) in_offsets, n);
+    f.write((const char*) in_sources, m);
+    f.write((const char*) in_labels, m);
+    return f.good();
+}
+
+// memory map a graph written by save
+CsrGraph* CsrGraph::load(const std::string& filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == -1 || info.st_size < (long) sizeof(CsrFileHeader))
+    {
+        close(fd);
+        return nullptr;
+    }
+    void* file = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the file is closed
+    close(fd);
+    if (file == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    // check the header and that the file holds all of the arrays (the
+    // counts must fit in an int)
+    const CsrFileHeader* header = (const CsrFileHeader*) file;
+    long n = header -> vertex_count;
+    long m = header -> edge_count;
+    if (memcmp(header -> magic, CSR_FILE_MAGIC, sizeof(header -> magic)) != 0 ||
+        header -> version != CSR_FILE_VERSION || n < 0 || m < 0 ||
+        n >= numeric_limits<int>::max() || m > numeric_limits<int>::max() ||
+        info.st_size != (long) sizeof(CsrFileHeader) + (2 * (n + 1) + 4 * m) * (long) sizeof(int))
+    {
+        munmap(file, info.st_size);
+        return nullptr;
+    }
+
+    // check the arrays so a corrupt file cannot send a traversal out of
+    // bounds
+    const int* outOffsets = (const int*) ((const char*) file + sizeof(CsrFileHeader));
+    const int* outTargets = outOffsets + n + 1;
+    const int* inOffsets = outTargets + 2 * m;
+    const int* inSources = inOffsets + n + 1;
+    if (!valid_csr_arrays(outOffsets, outTargets, n, m) ||
+        !valid_csr_arrays(inOffsets, inSources, n, m))
+    {
+        munmap(file, info.st_size);
+        return nullptr;
+    }
+
+    // point the arrays into the file (the graph is never written to, so
+    // the arrays can be used read only)
+    CsrGraph* g = new CsrGraph();
+    g -> number_of_vertices = n;
+    g -> number_of_edges = m;
+    g -> mapped_file = file;
+    g -> mapped_size = info.st_size;
+    int* arrays = (int*) ((char*) file + sizeof(CsrFileHeader));
+    g -> out_offsets = arrays;
+    g -> out_targets = g -> out_offsets + n + 1;
+    g -> out_labels = g -> out_targets + m;
+    g -> in_offsets = g -> out_labels + m;
+    g -> in_sources = g -> in_offsets + n + 1;
+    g -> in_labels = g -> in_sources + m;
+    return g;
+}
+
+// the graph is immutable, so this does nothing
+void CsrGraph::set_edge(int, int, int)
+{
+}
+
+// check if the given edge is in the graph
+bool CsrGraph::has_edge(int v1, int v2) const
+{
+    return find_edge(v1, v2) != -1;
+}
+
+// returns true if there is an edge between v1 and v2 in the graph
+// the output parameter returns the edge label
+bool CsrGraph::get_edge(int v1, int v2, int& edge) const
+{
+    int i = find_edge(v1, v2);
+    if (i == -1)
+    {
+        return false;
+    }
+    edge = out_labels[i];
+    return true;
+}
+
+// the graph is immutable, so this does nothing
+void CsrGraph::remove_edge(int, int)
+{
+}
+
+// get all vertices on an outgoing edge from given vertex
+void CsrGraph::connected_to(int v1, std::list<int>& vertices) const
+{
+    // check if vertex is out of bounds
+    if (!is_in_bounds_csr(v1, number_of_vertices))
+    {
+        return;
+    }
+    for (int i = out_offsets[v1]; i < out_offsets[v1 + 1]; ++i)
+    {
+        vertices.push_back(out_targets[i]);
+    }
+}
+
+// get all vertices on an incoming edge to given vertex
+void CsrGraph::connected_from(int v2, std::list<int>& vertices) const
+{
+    // check if vertex is out of bounds
+    if (!is_in_bounds_csr(v2, number_of_vertices))
+    {
+        return;
+    }
+    for (int i = in_offsets[v2]; i < in_offsets[v2 + 1]; ++i)
+    {
+        vertices.push_back(in_sources[i]);
+    }
+}
+
+// get all vertices adjacent to a vertex, that is, connected to or connected
+// from the vertex (may return duplicate vertices)
+void CsrGraph::adjacent(int v, std::list<int>& vertices) const
+{
+    connected_to(v, vertices);
+    connected_from(v, vertices);
+}
+
+// visit each outgoing edge of the given vertex
+bool CsrGraph::visit_connected_to(int v1, EdgeVisitor& visitor) const
+{
+    // check if vertex is out of bounds
+    if (!is_in_bounds_csr(v1, number_of_vertices))
+    {
+        return true;
+    }
+    for (int i = out_offsets[v1]; i < out_offsets[v1 + 1]; ++i)
+    {
+        if (!visitor.visit(out_targets[i], out_labels[i]))
+            return false;
+    }
+    return true;
+}
+
+// visit each incoming edge of the given vertex
+bool CsrGraph::visit_connected_from(int v2, EdgeVisitor& visitor) const
+{
+    // check if vertex is out of bounds
+    if (!is_in_bounds_csr(v2, number_of_vertices))
+    {
+        return true;
+    }
+    for (int i = in_offsets[v2]; i < in_offsets[v2 + 1]; ++i)
+    {
+        if (!visitor.visit(in_sources[i], in_labels[i]))
+            return false;
+    }
+    return true;
+}
+
+// get number of nodes in the graph
+int CsrGraph::vertex_count() const
+{
+    return number_of_vertices;
+}
+
+// get number of edges in the graph
+int CsrGraph::edge_count() const
+{
+    return number_of_edges;
+}
+
+// helper function to fill the arrays from an edge list
+void CsrGraph::build(const Edges& edges)
+{
+    int n = number_of_vertices;
+
+    // the out edges are the edges grouped by v1 and ordered by v2
+    vector<int> offsets, order;
+    group_edges(n, edges, offsets, order);
+
+    number_of_edges = order.size();
+    int m = number_of_edges;
+    out_offsets = new int[n + 1];
+    in_offsets = new int[n + 1];
+    out_targets = new int[m];
+    out_labels = new int[m];
+    in_sources = new int[m];
+    in_labels = new int[m];
+
+    copy(offsets.begin(), offsets.end(), out_offsets);
+    parallel_for(m, [&](int, int begin, int end) {
+        for (int k = begin; k < end; ++k)
+        {
+            out_targets[k] = get<2>(edges[order[k]]);
+            out_labels[k] = get<1>(edges[order[k]]);
+        }
+    });
+
+    // the in edges are the out edges grouped by v2 and ordered by v1
+    vector<int> inOrder;
+    parallel_bucket(m, n, [&](int k) { return out_targets[k]; }, offsets, inOrder);
+    copy(offsets.begin(), offsets.end(), in_offsets);
+    parallel_for(n, [&](int, int begin, int end) {
+        for (int v = begin; v < end; ++v)
+        {
+            sort(inOrder.begin() + in_offsets[v], inOrder.begin() + in_offsets[v + 1], [&](int a, int b) {
+                return get<0>(edges[order[a]]) < get<0>(edges[order[b]]);
+            });
+            for (int k = in_offsets[v]; k < in_offsets[v + 1]; ++k)
+            {
+                in_sources[k] = get<0>(edges[order[inOrder[k]]]);
+                in_labels[k] = out_labels[inOrder[k]];
+            }
+        }
+    });
+}
+
+// helper function to find the position of v2 in the out edges of v1
+// (returns -1 if there is no such edge)
+int CsrGraph::find_edge(int v1, int v2) const
+{
+    // check if the vertices are out of bounds
+    if (!is_in_bounds_csr(v1, v2, number_of_vertices))
+    {
+        return -1;
+    }
+    // out edges are sorted by target so binary search them
+    int* start = out_targets + out_offsets[v1];
+    int* end = out_targets + out_offsets[v1 + 1];
+    int* pos = lower_bound(start, end, v2);
+    if (pos == end || *pos != v2)
+    {
+        return -1;
+    }
+    return pos - out_targets;
+}
+
+// helper function to delete the arrays
+void CsrGraph::make_empty()
+{
+    // arrays in a mapped file are released with the mapping
+    if (mapped_file != nullptr)
+    {
+        munmap(mapped_file, mapped_size);
+        mapped_file = nullptr;
+        mapped_size = 0;
+        return;
+    }
+    delete[] out_offsets;
+    delete[] out_targets;
+    delete[] out_labels;
+    delete[] in_offsets;
+    delete[] in_sources;
+    delete[] in_labels;
+}
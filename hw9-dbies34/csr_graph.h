@@ -0,0 +1,125 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: csr_graph.h
+// DATE: Spring 2021
+// DESC: Immutable compressed-sparse-row implementation of the graph
+// interface. The out edges of vertex v are stored contiguously in
+// out_targets[out_offsets[v]] to out_targets[out_offsets[v+1]-1]
+// (sorted by target vertex), and similarly for the in edges.
+//
+// Binary file format (version 1, native byte order): a 24 byte header
+// of the 8 characters "CSRGRAPH", the version and vertex count as
+// 32-bit ints, and the edge count as a 64-bit int, followed by the
+// 32-bit int arrays out_offsets (n+1), out_targets (m), out_labels
+// (m), in_offsets (n+1), in_sources (m), and in_labels (m).
+//----------------------------------------------------------------------
+
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include "graph.h"
+#include <string>
+
+
+class CsrGraph : public Graph
+{
+public:
+
+  // build the graph from a list of (v1, edge_label, v2) edges, where
+  // edges with out of bounds vertices are ignored and a repeated edge
+  // keeps the last label given (as with set_edge)
+  CsrGraph(int vertex_count, const Edges& edges);
+
+  // destructor
+  ~CsrGraph();
+
+  // copy constructor
+  CsrGraph(const CsrGraph& rhs);
+
+  // assignment operator
+  CsrGraph& operator=(const CsrGraph& rhs);
+
+  // write the graph to the given file in the binary format, returns
+  // false if the file could not be written
+  bool save(const std::string& filename) const;
+
+  // memory map a graph written by save, where the arrays are used
+  // directly from the mapped file without parsing or copying. Returns
+  // nullptr if the file could not be mapped or is not a valid graph
+  // file, otherwise a new graph that the caller must delete.
+  static CsrGraph* load(const std::string& filename);
+
+  // the graph is immutable, so this does nothing: the edge is not
+  // added or updated and no error is reported
+  void set_edge(int v1, int edge_label, int v2);
+
+  // check if the given edge is in the graph
+  bool has_edge(int v1, int v2) const;
+
+  // returns true if there is an edge between v1 and v2 in the graph
+  // the output parameter returns the edge label
+  bool get_edge(int v1, int v2, int& edge) const;
+
+  // the graph is immutable, so this does nothing: the edge stays in
+  // the graph and no error is reported
+  void remove_edge(int v1, int v2);
+
+  // get all vertices on an outgoing edge from given vertex
+  void connected_to(int v1, std::list<int>& vertices) const;
+
+  // get all vertices on an incoming edge to given vertex
+  void connected_from(int v2, std::list<int>& vertices) const;
+
+  // get all vertices adjacent to a vertex, that is, connected to or connected
+  // from the vertex (may return duplicate vertices)
+  void adjacent(int v, std::list<int>& vertices) const;
+
+  // get number of nodes in the graph
+  int vertex_count() const;
+
+  // get number of edges in the graph
+  int edge_count() const;
+
+  // visit each outgoing edge of the given vertex
+  bool visit_connected_to(int v1, EdgeVisitor& visitor) const;
+
+  // visit each incoming edge of the given vertex
+  bool visit_connected_from(int v2, EdgeVisitor& visitor) const;
+
+private:
+
+  int number_of_vertices;
+  int number_of_edges;
+
+  // out edges (for connected_to), indexed by out_offsets
+  int* out_offsets;
+  int* out_targets;
+  int* out_labels;
+
+  // in edges (for connected_from), indexed by in_offsets
+  int* in_offsets;
+  int* in_sources;
+  int* in_labels;
+
+  // the mapped file the arrays point into (nullptr if the arrays were
+  // allocated with new)
+  void* mapped_file;
+  long mapped_size;
+
+  // empty graph used by load
+  CsrGraph();
+
+  // helper function to fill the arrays from an edge list
+  void build(const Edges& edges);
+
+  // helper function to find the position of v2 in the out edges of
+  // v1 (returns -1 if there is no such edge)
+  int find_edge(int v1, int v2) const;
+
+  // helper function to delete the arrays
+  void make_empty();
+
+};
+
+
+#endif
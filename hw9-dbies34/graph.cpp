@@ -8,14 +8,164 @@
 //----------------------------------------------------------------------
 
 #include "graph.h"
+#include "bit_adjacency_matrix.h"
+#include "parallel.h"
+#include "union_find.h"
 #include <stack>
 #include <iostream>
 #include <queue>
 #include <limits>
 #include <algorithm>
+#include <cstdint>
+#include <atomic>
 
 using namespace std;
 
+// direction-optimizing bfs switches to bottom-up once the frontier has
+// more than 1/BFS_ALPHA of the vertices not yet found, and back to
+// top-down once a shrinking frontier has less than 1/BFS_BETA of all
+// the vertices
+const int BFS_ALPHA = 15;
+const int BFS_BETA = 18;
+
+// copy a dense search tree into a map, leaving out vertices not found
+static void copy_tree(int src, const vector<int>& parents, Map& tree)
+{
+    if (src < 0 || src >= (int) parents.size())
+        return;
+    tree[src] = -1;
+    for (int v = 0; v < (int) parents.size(); ++v)
+    {
+        if (parents[v] != -1)
+            tree[v] = parents[v];
+    }
+}
+
+// copy each entry of a dense array into a map
+static void copy_values(const vector<int>& values, Map& map)
+{
+    for (int v = 0; v < (int) values.size(); ++v)
+    {
+        map[v] = values[v];
+    }
+}
+
+// visit each outgoing and then each incoming edge of the given vertex
+bool Graph::visit_adjacent(int v, EdgeVisitor& visitor) const
+{
+    return visit_connected_to(v, visitor) && visit_connected_from(v, visitor);
+}
+
+// add or update each edge in the batch
+void Graph::set_edges(const Edges& edges)
+{
+    for (const tuple<int, int, int>& edge : edges)
+    {
+        set_edge(get<0>(edge), get<1>(edge), get<2>(edge));
+    }
+}
+
+// report edge changes to the listener
+void Graph::add_listener(EdgeListener* listener)
+{
+    listeners.push_back(listener);
+}
+
+// stop reporting edge changes to the listener
+void Graph::remove_listener(EdgeListener* listener)
+{
+    listeners.erase(remove(listeners.begin(), listeners.end(), listener), listeners.end());
+}
+
+// check that each listener allows a new edge
+bool Graph::allow_new_edge(int v1, int v2)
+{
+    for (EdgeListener* listener : listeners)
+    {
+        if (!listener -> allow_edge(v1, v2))
+            return false;
+    }
+    return true;
+}
+
+// report a new edge to each listener
+void Graph::notify_edge_added(int v1, int v2)
+{
+    for (EdgeListener* listener : listeners)
+    {
+        listener -> edge_added(v1, v2);
+    }
+}
+
+// report a removed edge to each listener
+void Graph::notify_edge_removed(int v1, int v2)
+{
+    for (EdgeListener* listener : listeners)
+    {
+        listener -> edge_removed(v1, v2);
+    }
+}
+
+// report to each listener that the graph was assigned to
+void Graph::notify_graph_assigned()
+{
+    for (EdgeListener* listener : listeners)
+    {
+        listener -> graph_assigned();
+    }
+}
+
+// groups the in-bounds edges of a batch by v1 and orders each group by v2
+void Graph::group_edges(int vertex_count, const Edges& edges,
+                        std::vector<int>& offsets, std::vector<int>& order)
+{
+    int n = vertex_count;
+
+    // bucket the edges by v1, leaving out edges with invalid vertices
+    vector<int> bucketOffsets, items;
+    parallel_bucket(edges.size(), n, [&](int i) {
+        int v1 = get<0>(edges[i]), v2 = get<2>(edges[i]);
+        return (v1 >= 0 && v1 < n && v2 >= 0 && v2 < n) ? v1 : -1;
+    }, bucketOffsets, items);
+
+    // sort each bucket by v2 and then by position in the batch, and move
+    // the last edge of each run with the same v2 to the front
+    vector<int> keptCount(n);
+    parallel_for(n, [&](int, int begin, int end) {
+        for (int v = begin; v < end; ++v)
+        {
+            int first = bucketOffsets[v], last = bucketOffsets[v + 1];
+            sort(items.begin() + first, items.begin() + last, [&](int a, int b) {
+                int va = get<2>(edges[a]), vb = get<2>(edges[b]);
+                return va < vb || (va == vb && a < b);
+            });
+            int kept = 0;
+            for (int k = first; k < last; ++k)
+            {
+                if (k + 1 == last || get<2>(edges[items[k]]) != get<2>(edges[items[k + 1]]))
+                {
+                    items[first + kept++] = items[k];
+                }
+            }
+            keptCount[v] = kept;
+        }
+    });
+
+    offsets.assign(n + 1, 0);
+    for (int v = 0; v < n; ++v)
+    {
+        offsets[v + 1] = offsets[v] + keptCount[v];
+    }
+    order.resize(offsets[n]);
+    parallel_for(n, [&](int, int begin, int end) {
+        for (int v = begin; v < end; ++v)
+        {
+            copy(items.begin() + bucketOffsets[v], items.begin() + bucketOffsets[v] + keptCount[v],
+                 order.begin() + offsets[v]);
+        }
+    });
+}
+
 //----------------------------------------------------------------------
 // HW-3 graph operations
 //----------------------------------------------------------------------
@@ -31,48 +181,46 @@ using namespace std;
 //           source to their parent vertices
 //----------------------------------------------------------------------
 void Graph::bfs(bool dir, int src, Map &tree) const
+{
+    vector<int> parents;
+    bfs(dir, src, parents);
+    copy_tree(src, parents, tree);
+}
+
+//----------------------------------------------------------------------
+// Breadth-first search that fills a dense parent array.
+//
+// Outputs:
+//   tree -- tree[v] is the parent of v in the search tree, or -1 for
+//           the source and vertices not found (size vertex_count())
+//----------------------------------------------------------------------
+void Graph::bfs(bool dir, int src, std::vector<int> &tree) const
 {
     int size = vertex_count();
 
-    // create explored array
-    bool explored[size];
+    // no parents yet
+    tree.assign(size, -1);
+    if (src < 0 || src >= size)
+        return;
 
-    // mark all vertices as unexplored
-    for (int i = 0; i < size; i++)
-    {
-        explored[i] = false;
-    }
+    // create explored array
+    vector<bool> explored(size, false);
 
     // mark vertex v (src) as explored
     explored[src] = true;
 
-    // set the parent of s to -1 (denoting the root)
-    tree[src] = -1;
-
-    list<int> queue;
+    // each vertex is queued at most once, so the queue is an array
+    // with a moving front
+    vector<int> queue;
+    queue.reserve(size);
     queue.push_back(src);
 
-    while (!queue.empty())
+    for (int front = 0; front < (int) queue.size(); ++front)
     {
-        int currVertex = queue.front();
-
-        queue.pop_front();
-
-        list<int> vertices;
-        if (dir)
-        {
-            // use connected_to() for directed
-            connected_to(currVertex, vertices);
-        }
-        else
-        {
-            // use adjacent() for undirected
-            adjacent(currVertex, vertices);
-        }
+        int currVertex = queue[front];
 
-        for (list<int>::iterator it = vertices.begin(); it != vertices.end(); ++it)
-        {
-            int vertex = *it;
+        // use connected_to() for directed and adjacent() for undirected
+        for_each_neighbor(dir, currVertex, [&](int vertex, int) {
             if (!explored[vertex])
             {
                 // mark vertex as explored
@@ -82,8 +230,289 @@ void Graph::bfs(bool dir, int src, Map &tree) const
                 // add to the end of queue
                 queue.push_back(vertex);
             }
+        });
+    }
+}
+
+//----------------------------------------------------------------------
+// Direction-optimizing breadth-first search from a given source vertex.
+//
+// Inputs:
+//   dir -- true if directed
+//   src -- the source vertex
+// Outputs:
+//   tree -- search tree that maps vertices found from the source to
+//           their parent vertices
+//----------------------------------------------------------------------
+void Graph::direction_optimizing_bfs(bool dir, int src, Map &tree) const
+{
+    vector<int> parents;
+    direction_optimizing_bfs(dir, src, parents);
+    copy_tree(src, parents, tree);
+}
+
+//----------------------------------------------------------------------
+// Direction-optimizing breadth-first search that fills a dense parent
+// array (-1 for the source and vertices not found).
+//----------------------------------------------------------------------
+void Graph::direction_optimizing_bfs(bool dir, int src, std::vector<int> &tree) const
+{
+    int size = vertex_count();
+
+    // no parents yet
+    tree.assign(size, -1);
+    if (src < 0 || src >= size)
+        return;
+
+    // bitmaps of the found vertices and of the current frontier
+    int words = (size + 63) / 64;
+    vector<uint64_t> found(words, 0);
+    vector<uint64_t> frontierBits(words, 0);
+    found[src / 64] |= (uint64_t) 1 << (src % 64);
+
+    vector<int> frontier(1, src);
+    vector<int> next;
+    int notFound = size - 1;
+    bool bottomUp = false;
+
+    while (!frontier.empty())
+    {
+        // pick the direction of this level
+        int previous = next.size();
+        if (!bottomUp && (long) frontier.size() * BFS_ALPHA > notFound)
+            bottomUp = true;
+        else if (bottomUp && (int) frontier.size() < previous && (long) frontier.size() * BFS_BETA < size)
+            bottomUp = false;
+
+        next.clear();
+        if (!bottomUp)
+        {
+            // top-down: each frontier vertex claims its unfound neighbors
+            for (int u : frontier)
+            {
+                for_each_neighbor(dir, u, [&](int v, int) {
+                    uint64_t bit = (uint64_t) 1 << (v % 64);
+                    if (!(found[v / 64] & bit))
+                    {
+                        found[v / 64] |= bit;
+                        tree[v] = u;
+                        next.push_back(v);
+                    }
+                });
+            }
+        }
+        else
+        {
+            // bottom-up: each unfound vertex looks for a parent in the
+            // frontier over its incoming edges (or adjacent edges when
+            // undirected)
+            fill(frontierBits.begin(), frontierBits.end(), 0);
+            for (int u : frontier)
+            {
+                frontierBits[u / 64] |= (uint64_t) 1 << (u % 64);
+            }
+            for (int w = 0; w < words; ++w)
+            {
+                uint64_t unfound = ~found[w];
+                if (w == words - 1 && size % 64 != 0)
+                    unfound &= ((uint64_t) 1 << (size % 64)) - 1;
+                while (unfound != 0)
+                {
+                    int v = w * 64 + __builtin_ctzll(unfound);
+                    unfound &= unfound - 1;
+
+                    auto inFrontier = [&](int u, int) {
+                        if (!((frontierBits[u / 64] >> (u % 64)) & 1))
+                            return false;
+                        tree[v] = u;
+                        return true;
+                    };
+                    if (dir ? any_connected_from(v, inFrontier) : any_adjacent(v, inFrontier))
+                    {
+                        next.push_back(v);
+                    }
+                }
+            }
+            // mark the new vertices after the scan so that they are not
+            // used as parents on this level
+            for (int v : next)
+            {
+                found[v / 64] |= (uint64_t) 1 << (v % 64);
+            }
+        }
+        notFound -= next.size();
+
+        // the new level becomes the frontier (keeping the old size in
+        // next for the direction check)
+        frontier.swap(next);
+    }
+}
+
+//----------------------------------------------------------------------
+// Parallel level-synchronous breadth-first search from a given source
+// vertex.
+//
+// Inputs:
+//   dir -- true if directed
+//   src -- the source vertex
+// Outputs:
+//   tree -- search tree that maps vertices found from the source to
+//           their parent vertices
+//----------------------------------------------------------------------
+void Graph::parallel_bfs(bool dir, int src, Map &tree) const
+{
+    vector<int> parents;
+    parallel_bfs(dir, src, parents);
+    copy_tree(src, parents, tree);
+}
+
+//----------------------------------------------------------------------
+// Parallel breadth-first search that fills a dense parent array (-1 for
+// the source and vertices not found).
+//----------------------------------------------------------------------
+void Graph::parallel_bfs(bool dir, int src, std::vector<int> &tree) const
+{
+    int size = vertex_count();
+
+    // no parents yet
+    tree.assign(size, -1);
+    if (src < 0 || src >= size)
+        return;
+
+    // the source is its own parent until the search is done so that it
+    // cannot be claimed
+    vector<atomic<int>> parents(size);
+    parallel_for(size, [&](int, int begin, int end) {
+        for (int v = begin; v < end; ++v)
+            parents[v].store(-1, memory_order_relaxed);
+    });
+    parents[src].store(src, memory_order_relaxed);
+
+    vector<int> frontier(1, src);
+    vector<vector<int>> localNext;
+    while (!frontier.empty())
+    {
+        // each range of the frontier claims vertices into its own buffer
+        localNext.assign(parallel_ranges(frontier.size()), vector<int>());
+        parallel_for(frontier.size(), [&](int range, int begin, int end) {
+            vector<int>& next = localNext[range];
+            for (int i = begin; i < end; ++i)
+            {
+                int u = frontier[i];
+                for_each_neighbor(dir, u, [&](int v, int) {
+                    int unclaimed = -1;
+                    if (parents[v].load(memory_order_relaxed) == -1 &&
+                        parents[v].compare_exchange_strong(unclaimed, u, memory_order_relaxed))
+                    {
+                        next.push_back(v);
+                    }
+                });
+            }
+        });
+
+        // join the buffers into the next frontier
+        vector<int> offsets(localNext.size() + 1, 0);
+        for (int r = 0; r < (int) localNext.size(); ++r)
+        {
+            offsets[r + 1] = offsets[r] + localNext[r].size();
         }
+        frontier.resize(offsets.back());
+        parallel_tasks(localNext.size(), [&](int r) {
+            copy(localNext[r].begin(), localNext[r].end(), frontier.begin() + offsets[r]);
+        });
     }
+
+    parallel_for(size, [&](int, int begin, int end) {
+        for (int v = begin; v < end; ++v)
+            tree[v] = parents[v].load(memory_order_relaxed);
+    });
+    tree[src] = -1;
+}
+
+//----------------------------------------------------------------------
+// Breadth-first search from many sources at once, 64 sources to a
+// batch.
+//
+// Inputs:
+//   dir     -- true if directed
+//   sources -- the source vertices (may repeat)
+// Outputs:
+//   distances -- distances[i][v] is the number of edges on a shortest
+//                path from sources[i] to v, or -1 if v cannot be
+//                reached (one row per source)
+//----------------------------------------------------------------------
+void Graph::multi_source_bfs(bool dir, const std::vector<int>& sources,
+                             std::vector<std::vector<int>>& distances) const
+{
+    if (sources.empty())
+    {
+        distances.clear();
+        return;
+    }
+
+    int size = vertex_count();
+    int sourceCount = sources.size();
+    distances.assign(sourceCount, vector<int>(size, -1));
+
+    int batches = (sourceCount + 63) / 64;
+    int tasks = batches < thread_count() ? batches : thread_count();
+    parallel_tasks(tasks, [&](int task) {
+        // bit i of a word is search i of the batch
+        vector<uint64_t> seen(size), visit(size), visitNext(size);
+
+        for (int batch = task; batch < batches; batch += tasks)
+        {
+            int first = batch * 64;
+            int count = min(64, sourceCount - first);
+            fill(seen.begin(), seen.end(), 0);
+            fill(visit.begin(), visit.end(), 0);
+            fill(visitNext.begin(), visitNext.end(), 0);
+
+            for (int i = 0; i < count; ++i)
+            {
+                int src = sources[first + i];
+                if (src < 0 || src >= size)
+                    continue;
+                seen[src] |= (uint64_t) 1 << i;
+                visit[src] |= (uint64_t) 1 << i;
+                distances[first + i][src] = 0;
+            }
+
+            bool active = true;
+            for (int level = 1; active; ++level)
+            {
+                // push the searches at each vertex to its neighbors
+                for (int u = 0; u < size; ++u)
+                {
+                    uint64_t searches = visit[u];
+                    if (searches == 0)
+                        continue;
+                    for_each_neighbor(dir, u, [&](int v, int) {
+                        visitNext[v] |= searches;
+                    });
+                }
+
+                // keep the searches reaching a vertex for the first time
+                active = false;
+                for (int v = 0; v < size; ++v)
+                {
+                    uint64_t searches = visitNext[v] & ~seen[v];
+                    visitNext[v] = 0;
+                    visit[v] = searches;
+                    if (searches == 0)
+                        continue;
+                    active = true;
+                    seen[v] |= searches;
+                    while (searches != 0)
+                    {
+                        int i = __builtin_ctzll(searches);
+                        searches &= searches - 1;
+                        distances[first + i][v] = level;
+                    }
+                }
+            }
+        }
+    });
 }
 
 //----------------------------------------------------------------------
@@ -104,24 +533,76 @@ void Graph::shortest_path_length(bool dir, int src, int dst, std::list<int> &pat
     if (src == dst)
         return;
 
-    Map searchTree;
-    bfs(dir, src, searchTree);
+    int size = vertex_count();
+    if (src < 0 || src >= size || dst < 0 || dst >= size)
+    {
+        path.push_front(src);
+        return;
+    }
+
+    // the forward search keeps the parent of each vertex (toward src)
+    // and the backward search the next vertex (toward dst), along with
+    // the number of edges from src or to dst
+    vector<int> parent(size, -1), nextVertex(size, -1);
+    vector<int> srcDist(size, -1), dstDist(size, -1);
+    srcDist[src] = 0;
+    dstDist[dst] = 0;
+
+    vector<int> srcFrontier(1, src), dstFrontier(1, dst), next;
+    int meet = -1, meetLength = 0;
+    while (meet == -1 && !srcFrontier.empty() && !dstFrontier.empty())
+    {
+        // expand a whole level of the smaller frontier
+        bool forward = srcFrontier.size() <= dstFrontier.size();
+        vector<int>& frontier = forward ? srcFrontier : dstFrontier;
+        vector<int>& dist = forward ? srcDist : dstDist;
+        vector<int>& link = forward ? parent : nextVertex;
+        const vector<int>& otherDist = forward ? dstDist : srcDist;
+
+        next.clear();
+        for (int u : frontier)
+        {
+            auto expand = [&](int v, int) {
+                if (dist[v] != -1)
+                    return;
+                dist[v] = dist[u] + 1;
+                link[v] = u;
+                next.push_back(v);
+                // keep the shortest meeting point of the level
+                if (otherDist[v] != -1 && (meet == -1 || dist[v] + otherDist[v] < meetLength))
+                {
+                    meet = v;
+                    meetLength = dist[v] + otherDist[v];
+                }
+            };
+            // use adjacent() for undirected, connected_to() forward and
+            // connected_from() backward for directed
+            if (!dir)
+                for_each_adjacent(u, expand);
+            else if (forward)
+                for_each_connected_to(u, expand);
+            else
+                for_each_connected_from(u, expand);
+        }
+        frontier.swap(next);
+    }
 
     // return if the destination cannot be reached
-    if (searchTree.find(dst) == searchTree.end())
+    if (meet == -1)
     {
         path.push_front(src);
         return;
     }
-    path.push_front(dst);
 
-    int currVertex = searchTree[dst];
-    while (currVertex != src)
+    // src to the meeting point, then on to dst
+    for (int v = meet; v != -1; v = parent[v])
     {
-        path.push_front(currVertex);
-        currVertex = searchTree[currVertex];
+        path.push_front(v);
+    }
+    for (int v = nextVertex[meet]; v != -1; v = nextVertex[v])
+    {
+        path.push_back(v);
     }
-    path.push_front(src);
 }
 
 //----------------------------------------------------------------------
@@ -139,30 +620,204 @@ void Graph::shortest_path_length(bool dir, int src, int dst, std::list<int> &pat
 //----------------------------------------------------------------------
 void Graph::bfs_connected_components(Map &components) const
 {
-    // make a list of all the undiscovered vertices
-    list<int> undiscovered;
-    for (int i = 0; i < vertex_count(); ++i)
+    vector<int> numbers;
+    bfs_connected_components(numbers);
+    copy_values(numbers, components);
+}
+
+//----------------------------------------------------------------------
+// Connected components as a dense array.
+//
+// Outputs:
+//   components -- components[v] is the component number of v
+//   returns    -- the number of components c
+//----------------------------------------------------------------------
+int Graph::bfs_connected_components(std::vector<int> &components) const
+{
+    int size = vertex_count();
+
+    // -1 marks an undiscovered vertex
+    components.assign(size, -1);
+
+    int componentNum = 0;
+    vector<int> queue;
+    queue.reserve(size);
+    for (int i = 0; i < size; ++i)
     {
-        undiscovered.push_back(i);
+        if (components[i] != -1)
+            continue;
+
+        // bfs from the first undiscovered vertex labels its component
+        components[i] = componentNum;
+        queue.clear();
+        queue.push_back(i);
+        for (int front = 0; front < (int) queue.size(); ++front)
+        {
+            for_each_adjacent(queue[front], [&](int v, int) {
+                if (components[v] == -1)
+                {
+                    components[v] = componentNum;
+                    queue.push_back(v);
+                }
+            });
+        }
+        componentNum++;
+    }
+    return componentNum;
+}
+
+//----------------------------------------------------------------------
+// Find connected components by joining the ends of each edge in a
+// union-find.
+//
+// Outputs:
+//   components -- components[v] is the component number of v
+//   returns    -- the number of components c
+//----------------------------------------------------------------------
+int Graph::union_find_connected_components(std::vector<int> &components) const
+{
+    int size = vertex_count();
+    UnionFind sets(size);
+    for (int u = 0; u < size; ++u)
+    {
+        for_each_connected_to(u, [&](int v, int) { sets.join(u, v); });
     }
 
+    // number the components in order of their smallest vertex
+    components.assign(size, -1);
     int componentNum = 0;
-    Map searchTree;
-    while (!undiscovered.empty())
+    for (int v = 0; v < size; ++v)
+    {
+        int root = sets.find(v);
+        if (components[root] == -1)
+            components[root] = componentNum++;
+        components[v] = components[root];
+    }
+    return componentNum;
+}
+
+// hook the components of u and v together, where the larger component
+// id is hooked under the smaller
+static void afforest_link(int u, int v, vector<atomic<int>>& comp)
+{
+    int p1 = comp[u].load();
+    int p2 = comp[v].load();
+    while (p1 != p2)
     {
-        bfs(false, undiscovered.front(), searchTree);
+        int high = max(p1, p2);
+        int low = min(p1, p2);
+        int pHigh = comp[high].load();
+        // done if high was already hooked under low
+        if (pHigh == low)
+            break;
+        // hook high if it is still a root
+        if (pHigh == high && comp[high].compare_exchange_strong(pHigh, low))
+            break;
+        // otherwise move up and try again
+        p1 = comp[comp[high].load()].load();
+        p2 = comp[low].load();
+    }
+}
 
-        // iterate through the search tree
-        for (Map::iterator it = searchTree.begin(); it != searchTree.end(); ++it)
+// point each vertex straight at the root of its component
+static void afforest_compress(vector<atomic<int>>& comp)
+{
+    parallel_for(comp.size(), [&](int, int begin, int end) {
+        for (int v = begin; v < end; ++v)
         {
-            // set the vertex to the current component number
-            components[it->first] = componentNum;
-            // remove the vertex from the undiscovered list
-            undiscovered.remove(it->first);
+            while (comp[v].load() != comp[comp[v].load()].load())
+            {
+                comp[v].store(comp[comp[v].load()].load());
+            }
         }
-        searchTree.clear();
-        componentNum++;
+    });
+}
+
+//----------------------------------------------------------------------
+// Find connected components in parallel using Afforest.
+//
+// Outputs:
+//   components -- components[v] is the component number of v
+//   returns    -- the number of components c
+//----------------------------------------------------------------------
+int Graph::parallel_connected_components(std::vector<int> &components) const
+{
+    // number of neighbors each vertex is linked to before sampling, and
+    // number of vertices sampled to find the largest component
+    const int NEIGHBOR_ROUNDS = 2;
+    const int SAMPLES = 1024;
+
+    int size = vertex_count();
+    vector<atomic<int>> comp(size);
+    parallel_for(size, [&](int, int begin, int end) {
+        for (int v = begin; v < end; ++v)
+            comp[v].store(v);
+    });
+
+    // link each vertex to its first few outgoing neighbors
+    for (int r = 0; r < NEIGHBOR_ROUNDS; ++r)
+    {
+        parallel_for(size, [&](int, int begin, int end) {
+            for (int u = begin; u < end; ++u)
+            {
+                int i = 0;
+                any_connected_to(u, [&](int v, int) {
+                    if (i++ < r)
+                        return false;
+                    afforest_link(u, v, comp);
+                    return true;
+                });
+            }
+        });
+        afforest_compress(comp);
     }
+
+    // sample the most frequent component
+    int frequent = 0;
+    if (size > 0)
+    {
+        unordered_map<int, int> counts;
+        unsigned int seed = 27491095;
+        for (int i = 0; i < SAMPLES; ++i)
+        {
+            seed = seed * 1103515245 + 12345;
+            int c = comp[(seed >> 8) % size].load();
+            if (++counts[c] > counts[frequent])
+                frequent = c;
+        }
+    }
+
+    // link the remaining edges of vertices outside of the frequent
+    // component, including incoming edges since the outgoing edges of
+    // the frequent component are skipped
+    parallel_for(size, [&](int, int begin, int end) {
+        for (int u = begin; u < end; ++u)
+        {
+            if (comp[u].load() == frequent)
+                continue;
+            int i = 0;
+            for_each_connected_to(u, [&](int v, int) {
+                if (i++ >= NEIGHBOR_ROUNDS)
+                    afforest_link(u, v, comp);
+            });
+            for_each_connected_from(u, [&](int v, int) { afforest_link(u, v, comp); });
+        }
+    });
+    afforest_compress(comp);
+
+    // number the components in order of their smallest vertex (each
+    // root is the smallest vertex of its component)
+    components.assign(size, -1);
+    int componentNum = 0;
+    for (int v = 0; v < size; ++v)
+    {
+        int root = comp[v].load();
+        if (root == v)
+            components[v] = componentNum++;
+        else
+            components[v] = components[root];
+    }
+    return componentNum;
 }
 
 //----------------------------------------------------------------------
@@ -177,55 +832,149 @@ void Graph::bfs_connected_components(Map &components) const
 //----------------------------------------------------------------------
 bool Graph::bipartite_graph(Map &coloring) const
 {
-    list<int> undiscovered;
-
-    // set all the vertices to no color
-    for (int i = 0; i < vertex_count(); ++i)
-    {
-        coloring[i] = -1;
-        undiscovered.push_front(i);
-    }
-
-    coloring[0] = 1;
-
-    list<int> queue;
-    queue.push_front(0);
-    undiscovered.remove(0);
+    vector<int> colors;
+    bool isBipartite = bipartite_graph(colors);
+    copy_values(colors, coloring);
+    return isBipartite;
+}
 
-    while (!undiscovered.empty() || !queue.empty())
-    {
-        int u = queue.front();
-        queue.pop_front();
+//----------------------------------------------------------------------
+// Bipartite test that fills a dense coloring array.
+//
+// Outputs:
+//   returns  -- true if the graph is bipartite, false otherwise
+//   coloring -- coloring[v] is the color (either 0 or 1) of v if the
+//               graph is bipartite
+//----------------------------------------------------------------------
+bool Graph::bipartite_graph(std::vector<int> &coloring) const
+{
+    vector<int> oddCycle;
+    return bipartite_graph(coloring, oddCycle);
+}
 
-        list<int> adjacentVertices;
-        adjacent(u, adjacentVertices);
+//----------------------------------------------------------------------
+// Bipartite test that also finds an odd cycle when the graph is not
+// bipartite.
+//
+// Outputs:
+//   returns   -- true if the graph is bipartite, false otherwise
+//   coloring  -- coloring[v] is the color (either 0 or 1) of v if the
+//                graph is bipartite
+//   odd_cycle -- if the graph is not bipartite, the vertices of an odd
+//                cycle in order
+//----------------------------------------------------------------------
+bool Graph::bipartite_graph(std::vector<int> &coloring, std::vector<int> &odd_cycle) const
+{
+    int size = vertex_count();
 
-        for (list<int>::iterator it = adjacentVertices.begin(); it != adjacentVertices.end(); ++it)
+    // set all the vertices to no color
+    coloring.assign(size, -1);
+    odd_cycle.clear();
+
+    // bfs tree of each component, used to find the odd cycle
+    vector<int> parent(size, -1), depth(size, 0);
+
+    // set once a component is found not to be bipartite
+    atomic<bool> failed(false);
+
+    // color the component of the given vertex, returns false (after
+    // finding the odd cycle) if two adjacent vertices have the same color
+    auto colorComponent = [&](int start, vector<int>& queue) {
+        // the first vertex of each component is colored 1
+        coloring[start] = 1;
+        queue.clear();
+        queue.push_back(start);
+        for (int front = 0; front < (int) queue.size() && !failed.load(); ++front)
         {
-            int vertex = *it;
+            int u = queue[front];
+            int conflict = -1;
+            any_adjacent(u, [&](int vertex, int) {
+                // check for no coloring
+                if (coloring[vertex] == -1)
+                {
+                    // color the vertex the opposite of the parent vertex
+                    coloring[vertex] = 1 - coloring[u];
+                    parent[vertex] = u;
+                    depth[vertex] = depth[u] + 1;
+                    queue.push_back(vertex);
+                }
+                // stop if the vertex color is the same as the parent color
+                else if (coloring[vertex] == coloring[u])
+                {
+                    conflict = vertex;
+                }
+                return conflict != -1;
+            });
+            if (conflict == -1)
+                continue;
+
+            // only the first component to fail reports its cycle
+            bool expected = false;
+            if (!failed.compare_exchange_strong(expected, true))
+                return false;
 
-            // check for no coloring
-            if (coloring[vertex] == -1)
+            // u and conflict are at depths of the same parity, so the tree
+            // paths up to their common ancestor and the edge between them
+            // form an odd cycle
+            vector<int> fromU, fromConflict;
+            int a = u, b = conflict;
+            while (depth[a] > depth[b])
             {
-                undiscovered.remove(vertex);
-                // color the vertex the opposite of the parent vertex
-                coloring[vertex] = 1 - coloring[u];
-                // add to the queue
-                queue.push_front(vertex);
+                fromU.push_back(a);
+                a = parent[a];
             }
-            // check if the current vertex color is the same as the parent color
-            else if (coloring[vertex] == coloring[u])
+            while (depth[b] > depth[a])
             {
-                return false;
+                fromConflict.push_back(b);
+                b = parent[b];
+            }
+            while (a != b)
+            {
+                fromU.push_back(a);
+                fromConflict.push_back(b);
+                a = parent[a];
+                b = parent[b];
             }
+            fromU.push_back(a);
+            odd_cycle.assign(fromU.begin(), fromU.end());
+            odd_cycle.insert(odd_cycle.end(), fromConflict.rbegin(), fromConflict.rend());
+            return false;
         }
-        if (queue.empty() && !undiscovered.empty())
+        return !failed.load();
+    };
+
+    // small graphs are colored one component at a time
+    int tasks = parallel_ranges(size);
+    if (tasks == 1)
+    {
+        vector<int> queue;
+        queue.reserve(size);
+        for (int i = 0; i < size; ++i)
         {
-            queue.push_front(undiscovered.front());
-            undiscovered.pop_front();
+            if (coloring[i] == -1 && !colorComponent(i, queue))
+                return false;
         }
+        return true;
     }
-    return true;
+
+    // otherwise threads take turns claiming the next component, starting
+    // each component at its smallest vertex
+    vector<int> components;
+    int componentCount = parallel_connected_components(components);
+    vector<int> starts(componentCount, -1);
+    for (int v = size - 1; v >= 0; --v)
+    {
+        starts[components[v]] = v;
+    }
+    atomic<int> nextComponent(0);
+    parallel_tasks(min(tasks, componentCount), [&](int) {
+        vector<int> queue;
+        for (int c = nextComponent++; c < componentCount && !failed.load(); c = nextComponent++)
+        {
+            colorComponent(starts[c], queue);
+        }
+    });
+    return !failed.load();
 }
 
 //----------------------------------------------------------------------
@@ -240,58 +989,29 @@ bool Graph::bipartite_graph(Map &coloring) const
 //----------------------------------------------------------------------
 void Graph::dfs(bool dir, int src, Map &tree) const
 {
-    bool explored[vertex_count()];
-
-    // mark all vertices as unexplored
-    for (int i = 0; i < vertex_count(); i++)
-    {
-        explored[i] = false;
-    }
-
-    stack <int> s;
-
-    s.push(src);
-    // src is the root of the tree
-    tree[src] = -1;
-    explored[src] = true;
-
-    while (!s.empty())
-    {
-        // parent vertex
-        int u = s.top();
-        
-        list <int> vertices;
-
-        if (dir)
-        {
-            // use connected_to() for directed
-            connected_to(u, vertices);
-        }
-        else
-        {
-            // use adjacent() for undirected
-            adjacent(u, vertices);
-        }
-
-        bool isDeadEnd = true;
-        for (list<int>::iterator it = vertices.begin(); it != vertices.end(); ++it)
-        {
-            // current vertex
-            int v = *it;
-
-            if (!explored[v])
-            {
-                tree[v] = u;
-                explored[v] = true;
-                s.push(v);
-                isDeadEnd = false;
-            }
-        }
+    vector<int> parents;
+    dfs(dir, src, parents);
+    copy_tree(src, parents, tree);
+}
 
-        // pop the stack if there is a dead end
-        if (isDeadEnd)
-            s.pop();
-    }
+//----------------------------------------------------------------------
+// Depth-first search that fills a dense parent array.
+//
+// Outputs:
+//   tree -- tree[v] is the parent of v in the search tree, or -1 for
+//           the source and vertices not found (size vertex_count())
+//----------------------------------------------------------------------
+void Graph::dfs(bool dir, int src, std::vector<int> &tree) const
+{
+    // no parents yet
+    tree.assign(vertex_count(), -1);
+
+    // follow outgoing edges for directed and adjacent edges for undirected
+    vector<bool> discovered(vertex_count(), false);
+    depth_first_search(dir ? OUT_EDGES : ALL_EDGES, src, discovered,
+                       [&](int v, int parent) { tree[v] = parent; },
+                       [](int, int) { return true; },
+                       [](int) {});
 }
 
 //----------------------------------------------------------------------
@@ -304,70 +1024,37 @@ void Graph::dfs(bool dir, int src, Map &tree) const
 //----------------------------------------------------------------------
 bool Graph::acyclic(bool dir) const
 {
-    Map coloring;
+    int size = vertex_count();
 
-    for (int i = 0; i < vertex_count(); i++)
-    {
-        // set every color to 0 (WHITE)
-        coloring[i] = 0;
-    }
+    // a vertex is on the stack (GRAY) from pre until post
+    vector<bool> discovered(size, false), onStack(size, false);
+    vector<int> parent(size, -1);
+    // undirected searches see the tree edge back to the parent once
+    vector<bool> parentSeen(size, false);
 
-    for (int i = 0; i < vertex_count(); i++)
+    for (int i = 0; i < size; i++)
     {
-        if (coloring[i] != 2)
-        {
-            stack <int> s;
-            s.push(i);
-
-            while (!s.empty())
-            {
-                list <int> vertices;
-                int u = s.top();
-
-                // set the color to 1 (GRAY)
-                coloring[u] = 1;
-
+        bool noCycle = depth_first_search(dir ? OUT_EDGES : ALL_EDGES, i, discovered,
+            [&](int v, int p) {
+                onStack[v] = true;
+                parent[v] = p;
+            },
+            [&](int u, int v) {
+                // directed cycles have an edge back to a vertex on the stack
                 if (dir)
+                    return !onStack[v];
+                // undirected cycles have any other edge to a discovered
+                // vertex (including a second edge to the parent)
+                if (v == parent[u] && !parentSeen[u])
                 {
-                    // use connected_to() for directed
-                    connected_to(u, vertices);
-                }
-                else
-                {
-                    // use adjacent() for undirected
-                    adjacent(u, vertices);
-                }
-
-                bool deadEnd = true;
-                // kepp track of adj grays for undirected graphs
-                int grayCount = 0;
-                for (list<int>::iterator it = vertices.begin(); it != vertices.end(); ++it)
-                {
-                    int v = *it;
-                    
-                    if(coloring[v] == 0)
-                    {
-                        s.push(v);
-                        deadEnd = false;
-
-                    } else if(coloring[v] == 1)
-                    {
-                        grayCount++;
-                        // undirected cycles must be touching two gray vertices
-                        if (dir || (grayCount > 1 && !dir))
-                            return false;
-                    }
-                    
-                }
-                // set the vertex to black if its a dead end
-                if (deadEnd || (!dir && grayCount == 1 && vertices.size() == 1))
-                {
-                    coloring[u] = 2;
-                    s.pop();
+                    parentSeen[u] = true;
+                    return true;
                 }
-            }
-        }
-        
+                return false;
+            },
+            [&](int v) { onStack[v] = false; });
+        if (!noCycle)
+            return false;
     }
     return true;
 }
@@ -387,53 +1074,110 @@ bool Graph::acyclic(bool dir) const
 //----------------------------------------------------------------------
 void Graph::unweighted_transitive_closure(bool dir, Graph &closed_graph) const
 {
-    
     int size = vertex_count();
+    vector<bool> discovered(size);
 
     for (int i = 0; i < size; i++)
     {
-        stack <int> s;
-        s.push(i);
-        
-        bool explored[vertex_count()] = {false};
-
-        explored[i] = true;
-
-        while (!s.empty())
-        {
-            list <int> vertices;
-            // parent vertex
-            int u = s.top();
+        // add an edge from i to each vertex its search finds
+        fill(discovered.begin(), discovered.end(), false);
+        depth_first_search(dir ? OUT_EDGES : ALL_EDGES, i, discovered,
+                           [&](int v, int) {
+                               if (v != i)
+                                   closed_graph.set_edge(i, 0, v);
+                           },
+                           [](int, int) { return true; },
+                           [](int) {});
+    }
+}
 
-            if (dir)
-            {
-                // use connected_to() for directed
-                connected_to(u, vertices);
-            }
-            else
+//----------------------------------------------------------------------
+// Computes the transitive closure as a bit matrix, from the
+// reachability of each strongly connected component.
+//
+// Outputs:
+//   closure -- has an edge i->v for each vertex v other than i
+//              reachable from i
+//----------------------------------------------------------------------
+void Graph::bit_transitive_closure(BitAdjacencyMatrix& closure) const
+{
+    // the rows must have room for every vertex
+    int size = vertex_count();
+    if (closure.vertex_count() != size)
+    {
+        return;
+    }
+    Condensation dag;
+    condensation(dag);
+    int count = dag.component_count();
+
+    // the level of a component is the length of the longest path from it
+    // in the condensation, so its targets are all on lower levels
+    vector<int> level(count, 0);
+    int levels = 0;
+    for (int c = count - 1; c >= 0; c--)
+    {
+        for (int k = dag.offsets[c]; k < dag.offsets[c + 1]; k++)
+        {
+            level[c] = max(level[c], level[dag.targets[k]] + 1);
+        }
+        levels = max(levels, level[c] + 1);
+    }
+    vector<int> levelOffsets, levelComps;
+    parallel_bucket(count, levels, [&](int c) { return level[c]; }, levelOffsets, levelComps);
+
+    // reach holds a bit per component for each component, set if the
+    // component can be reached from it (including itself)
+    long words = (count + 63) / 64;
+    vector<uint64_t> reach(count * words, 0);
+    for (int l = 0; l < levels; l++)
+    {
+        int first = levelOffsets[l];
+        parallel_for(levelOffsets[l + 1] - first, [&](int, int begin, int end) {
+            for (int i = first + begin; i < first + end; i++)
             {
-                // use adjacent() for undirected
-                adjacent(u, vertices);
+                int c = levelComps[i];
+                uint64_t* row = &reach[c * words];
+                row[c / 64] |= (uint64_t) 1 << (c % 64);
+                for (int k = dag.offsets[c]; k < dag.offsets[c + 1]; k++)
+                {
+                    const uint64_t* from = &reach[dag.targets[k] * words];
+                    for (long w = 0; w < words; w++)
+                    {
+                        row[w] |= from[w];
+                    }
+                }
             }
+        });
+    }
 
-            bool isDeadEnd = true;
-            for (list<int>::iterator it = vertices.begin(); it != vertices.end(); ++it)
+    // expand each component's row to a row of vertices shared by its
+    // members, leaving out the member itself
+    vector<uint64_t> vertexRow(closure.row_words());
+    for (int c = 0; c < count; c++)
+    {
+        fill(vertexRow.begin(), vertexRow.end(), 0);
+        const uint64_t* row = &reach[c * words];
+        for (long w = 0; w < words; w++)
+        {
+            uint64_t bits = row[w];
+            while (bits != 0)
             {
-                // current vertex
-                int v = *it;
-
-                if (!explored[v])
+                int d = w * 64 + __builtin_ctzll(bits);
+                bits &= bits - 1;
+                for (int k = dag.member_offsets[d]; k < dag.member_offsets[d + 1]; k++)
                 {
-                    closed_graph.set_edge(i, 0, v);
-                    explored[v] = true;
-                    s.push(v);
-                    isDeadEnd = false;
+                    int v = dag.members[k];
+                    vertexRow[v / 64] |= (uint64_t) 1 << (v % 64);
                 }
             }
-
-            // pop if there is a dead end
-            if (isDeadEnd)
-                s.pop();
+        }
+        for (int k = dag.member_offsets[c]; k < dag.member_offsets[c + 1]; k++)
+        {
+            int v = dag.members[k];
+            vertexRow[v / 64] &= ~((uint64_t) 1 << (v % 64));
+            closure.add_out_row(v, vertexRow.data());
+            vertexRow[v / 64] |= (uint64_t) 1 << (v % 64);
         }
     }
 }
@@ -450,64 +1194,32 @@ void Graph::unweighted_transitive_closure(bool dir, Graph &closed_graph) const
 //----------------------------------------------------------------------
 void Graph::dfs_topological_sort(Map &vertex_ordering) const
 {
-    bool explored[vertex_count()] = {false};
-    bool addedToStack[vertex_count()] = {false};
+    vector<int> ordering;
+    dfs_topological_sort(ordering);
+    copy_values(ordering, vertex_ordering);
+}
 
+//----------------------------------------------------------------------
+// Topological sort that fills a dense ordering array.
+//
+// Outputs:
+//   vertex_ordering -- vertex_ordering[v] is the order of v in the
+//                      topological sort (from 1 to n)
+//----------------------------------------------------------------------
+void Graph::dfs_topological_sort(std::vector<int> &vertex_ordering) const
+{
     int size = vertex_count();
-    
+    vector<bool> discovered(size, false);
+    vertex_ordering.assign(size, 0);
 
-    stack <int> topStack;
-
-    // look through every unexplored vertex
+    // the last vertex to finish is ordered first
+    int order = size;
     for (int i = 0; i < size; i++)
     {
-        if (!explored[i])
-        {
-            stack <int> s;
-            s.push(i);
-            
-            while (!s.empty())
-            {
-                list <int> vertices;
-                int u = s.top();
-
-                explored[u] = true;
-
-                // use connected_to() for directed
-                connected_to(u, vertices);
-
-                bool isDeadEnd = true;
-                for (list<int>::iterator it = vertices.begin(); it != vertices.end(); ++it)
-                {
-                    int v = *it;
-
-                    // check for a dead end
-                    if (!explored[v])
-                    {
-                        isDeadEnd = false;
-                        s.push(v);
-                    }
-                }
-
-                // if its a new dead end add to the sorting stack and pop
-                if (isDeadEnd)
-                {
-                    if (!addedToStack[u])
-                    {
-                        topStack.push(u);
-                        addedToStack[u] = true;
-                    }
-                    s.pop();
-                }
-            }
-        }
-    }
-
-    // add the sorting stack to the ordering map
-    for (int i = 1; i <= size; i++)
-    {
-        vertex_ordering[topStack.top()] = i;
-        topStack.pop();
+        depth_first_search(OUT_EDGES, i, discovered,
+                           [](int, int) {},
+                           [](int, int) { return true; },
+                           [&](int v) { vertex_ordering[v] = order--; });
     }
 }
 
@@ -527,78 +1239,352 @@ void Graph::dfs_topological_sort(Map &vertex_ordering) const
 //----------------------------------------------------------------------
 void Graph::strongly_connected_components(Map& components) const
 {
-    bool explored[vertex_count()] = {false};
-    int clock = 0;
-    Map postTimes;
-    list<int> ordering;
+    vector<int> numbers;
+    strongly_connected_components(numbers);
+    copy_values(numbers, components);
+}
 
-    // look through every unexplored vertex
-    for (int i = 0; i < vertex_count(); i++)
+//----------------------------------------------------------------------
+// Strongly connected components as a dense array, using Pearce's
+// single pass version of Tarjan's algorithm.
+//
+// Outputs:
+//   components -- components[v] is the component number of v, in
+//                 topological order
+//   returns    -- the number of components c
+//----------------------------------------------------------------------
+int Graph::strongly_connected_components(std::vector<int>& components) const
+{
+    int size = vertex_count();
+
+    // rindex[v] is the lowest visit index reachable from v while v is
+    // on the search, and then the component of v once it is assigned.
+    // Components are assigned from size-1 down, which is always above
+    // the visit indexes still in use.
+    vector<int> rindex(size, 0), parent(size, -1);
+    vector<bool> isRoot(size, false), discovered(size, false);
+    vector<int> stack;
+    int index = 1;
+    int component = size - 1;
+
+    for (int i = 0; i < size; i++)
     {
-        if (!explored[i])
-        {
-            stack <int> s;
-            clock++;
+        depth_first_search(OUT_EDGES, i, discovered,
+            [&](int v, int p) {
+                parent[v] = p;
+                isRoot[v] = true;
+                rindex[v] = index++;
+            },
+            [&](int u, int v) {
+                // an edge to a vertex still on the search joins u to it
+                if (rindex[v] < rindex[u])
+                {
+                    rindex[u] = rindex[v];
+                    isRoot[u] = false;
+                }
+                return true;
+            },
+            [&](int v) {
+                if (isRoot[v])
+                {
+                    // v and the vertices above it on the stack form a
+                    // component
+                    index--;
+                    while (!stack.empty() && rindex[v] <= rindex[stack.back()])
+                    {
+                        rindex[stack.back()] = component;
+                        stack.pop_back();
+                        index--;
+                    }
+                    rindex[v] = component--;
+                }
+                else
+                {
+                    stack.push_back(v);
+                }
+                // pass the lowest index up to the parent
+                int p = parent[v];
+                if (p != -1 && rindex[v] < rindex[p])
+                {
+                    rindex[p] = rindex[v];
+                    isRoot[p] = false;
+                }
+            });
+    }
 
-            s.push(i);
+    // components are assigned sinks first, so counting up from the last
+    // component assigned gives a topological order
+    int count = size - 1 - component;
+    components.resize(size);
+    for (int v = 0; v < size; v++)
+    {
+        components[v] = rindex[v] - component - 1;
+    }
+    return count;
+}
 
-            explored[i] = true;
+//----------------------------------------------------------------------
+// Computes the condensation of the graph.
+//
+// Outputs:
+//   dag -- the components, their members, and the edges between them
+//----------------------------------------------------------------------
+void Graph::condensation(Condensation& dag) const
+{
+    int size = vertex_count();
+    int count = strongly_connected_components(dag.components);
 
-            while (!s.empty())
-            {
-                // parent vertex
-                int u = s.top();
-                
-                list <int> vertices;
+    // group the vertices by component (in increasing order)
+    dag.member_offsets.assign(count + 1, 0);
+    for (int v = 0; v < size; v++)
+    {
+        dag.member_offsets[dag.components[v] + 1]++;
+    }
+    for (int c = 0; c < count; c++)
+    {
+        dag.member_offsets[c + 1] += dag.member_offsets[c];
+    }
+    dag.members.resize(size);
+    vector<int> next(dag.member_offsets.begin(), dag.member_offsets.end() - 1);
+    for (int v = 0; v < size; v++)
+    {
+        dag.members[next[dag.components[v]]++] = v;
+    }
+
+    // collect the edges leaving each component, where lastSource[j] is
+    // the last component an edge to j was added from
+    vector<int> lastSource(count, -1);
+    dag.offsets.assign(count + 1, 0);
+    dag.targets.clear();
+    for (int c = 0; c < count; c++)
+    {
+        for (int k = dag.member_offsets[c]; k < dag.member_offsets[c + 1]; k++)
+        {
+            for_each_connected_to(dag.members[k], [&](int v, int) {
+                int d = dag.components[v];
+                if (d != c && lastSource[d] != c)
+                {
+                    lastSource[d] = c;
+                    dag.targets.push_back(d);
+                }
+            });
+        }
+        sort(dag.targets.begin() + dag.offsets[c], dag.targets.end());
+        dag.offsets[c + 1] = dag.targets.size();
+    }
+}
+
+//----------------------------------------------------------------------
+// Computes the strongly connected components in parallel by trimming,
+// forward-backward search, and coloring.
+//
+// Outputs:
+//   components -- components[v] is the component number of v, in order
+//                 of the smallest vertex of each component
+//   returns    -- the number of components c
+//----------------------------------------------------------------------
+int Graph::parallel_strongly_connected_components(std::vector<int>& components) const
+{
+    // rounds of trimming before the forward-backward search
+    const int TRIM_ROUNDS = 3;
 
-                // use connected_from() for reverse graph
-                connected_from(u, vertices);
+    int size = vertex_count();
 
-                bool isDeadEnd = true;
-                for (list<int>::iterator it = vertices.begin(); it != vertices.end(); ++it)
+    // the vertex each vertex's component is named after, or -1 while
+    // the vertex remains
+    vector<atomic<int>> comp(size);
+    parallel_for(size, [&](int, int begin, int end) {
+        for (int v = begin; v < end; ++v)
+            comp[v].store(-1, memory_order_relaxed);
+    });
+    auto remains = [&](int v) { return comp[v].load(memory_order_relaxed) == -1; };
+
+    // trim vertices without a remaining incoming or outgoing neighbor
+    for (int round = 0; round < TRIM_ROUNDS; ++round)
+    {
+        atomic<bool> trimmed(false);
+        parallel_for(size, [&](int, int begin, int end) {
+            for (int v = begin; v < end; ++v)
+            {
+                if (!remains(v))
+                    continue;
+                auto remainingNeighbor = [&](int u, int) { return remains(u); };
+                if (!any_connected_to(v, remainingNeighbor) || !any_connected_from(v, remainingNeighbor))
                 {
-                    // current vertex
-                    int v = *it;
+                    comp[v].store(v, memory_order_relaxed);
+                    trimmed.store(true, memory_order_relaxed);
+                }
+            }
+        });
+        if (!trimmed.load())
+            break;
+    }
+
+    // pick the remaining vertex with the most edges as the pivot
+    vector<long> rangeBest(parallel_ranges(size), -1);
+    vector<int> rangePivot(parallel_ranges(size), -1);
+    parallel_for(size, [&](int range, int begin, int end) {
+        for (int v = begin; v < end; ++v)
+        {
+            if (!remains(v))
+                continue;
+            long in = 0, out = 0;
+            for_each_connected_to(v, [&](int, int) { out++; });
+            for_each_connected_from(v, [&](int, int) { in++; });
+            if (in * out > rangeBest[range])
+            {
+                rangeBest[range] = in * out;
+                rangePivot[range] = v;
+            }
+        }
+    });
+    int pivot = -1;
+    long best = -1;
+    for (int r = 0; r < (int) rangePivot.size(); ++r)
+    {
+        if (rangePivot[r] != -1 && rangeBest[r] > best)
+        {
+            best = rangeBest[r];
+            pivot = rangePivot[r];
+        }
+    }
 
-                    if (!explored[v])
+    // the pivot's component is reachable from it and reaches it
+    if (pivot != -1)
+    {
+        // bit 1 is set for vertices reachable from the pivot and bit 2
+        // for vertices reaching it
+        vector<atomic<int>> reached(size);
+        parallel_for(size, [&](int, int begin, int end) {
+            for (int v = begin; v < end; ++v)
+                reached[v].store(0, memory_order_relaxed);
+        });
+        for (int bit = 1; bit <= 2; ++bit)
+        {
+            reached[pivot].fetch_or(bit);
+            vector<int> frontier(1, pivot);
+            vector<vector<int>> localNext;
+            while (!frontier.empty())
+            {
+                localNext.assign(parallel_ranges(frontier.size()), vector<int>());
+                parallel_for(frontier.size(), [&](int range, int begin, int end) {
+                    auto claim = [&](int v, int) {
+                        if (remains(v) && !(reached[v].fetch_or(bit) & bit))
+                            localNext[range].push_back(v);
+                    };
+                    for (int i = begin; i < end; ++i)
                     {
-                        clock++;
-                        explored[v] = true;
-                        s.push(v);
-                        isDeadEnd = false;
+                        if (bit == 1)
+                            for_each_connected_to(frontier[i], claim);
+                        else
+                            for_each_connected_from(frontier[i], claim);
                     }
+                });
+                frontier.clear();
+                for (vector<int>& next : localNext)
+                    frontier.insert(frontier.end(), next.begin(), next.end());
+            }
+        }
+        parallel_for(size, [&](int, int begin, int end) {
+            for (int v = begin; v < end; ++v)
+            {
+                if (reached[v].load(memory_order_relaxed) == 3)
+                    comp[v].store(pivot, memory_order_relaxed);
+            }
+        });
+    }
+
+    // color the rest until every vertex has a component
+    vector<atomic<int>> color(size);
+    vector<int> remaining;
+    for (int v = 0; v < size; ++v)
+    {
+        if (remains(v))
+            remaining.push_back(v);
+    }
+    while (!remaining.empty())
+    {
+        int count = remaining.size();
+        parallel_for(count, [&](int, int begin, int end) {
+            for (int i = begin; i < end; ++i)
+                color[remaining[i]].store(remaining[i], memory_order_relaxed);
+        });
+
+        // spread the largest color along the edges until nothing changes
+        atomic<bool> changed(true);
+        while (changed.load())
+        {
+            changed.store(false);
+            parallel_for(count, [&](int, int begin, int end) {
+                for (int i = begin; i < end; ++i)
+                {
+                    int u = remaining[i];
+                    int c = color[u].load(memory_order_relaxed);
+                    for_each_connected_to(u, [&](int v, int) {
+                        if (!remains(v))
+                            return;
+                        int old = color[v].load(memory_order_relaxed);
+                        while (old < c && !color[v].compare_exchange_weak(old, c, memory_order_relaxed))
+                        {
+                        }
+                        if (old < c)
+                            changed.store(true, memory_order_relaxed);
+                    });
                 }
+            });
+        }
 
-                // pop the stack if there is a dead end
-                if (isDeadEnd)
+        // each root takes the vertices of its color that reach it
+        vector<int> roots;
+        for (int v : remaining)
+        {
+            if (color[v].load(memory_order_relaxed) == v)
+                roots.push_back(v);
+        }
+        atomic<int> nextRoot(0);
+        int tasks = min(parallel_ranges(count), (int) roots.size());
+        parallel_tasks(tasks, [&](int) {
+            vector<int> queue;
+            for (int r = nextRoot++; r < (int) roots.size(); r = nextRoot++)
+            {
+                int root = roots[r];
+                comp[root].store(root, memory_order_relaxed);
+                queue.assign(1, root);
+                for (int front = 0; front < (int) queue.size(); ++front)
                 {
-                    // set the post time of the vertex
-                    postTimes[s.top()] = clock++;
-                    // add to the vertex ordering 
-                    ordering.push_back(s.top());
-                    s.pop();
+                    for_each_connected_from(queue[front], [&](int v, int) {
+                        if (remains(v) && color[v].load(memory_order_relaxed) == root)
+                        {
+                            comp[v].store(root, memory_order_relaxed);
+                            queue.push_back(v);
+                        }
+                    });
                 }
             }
+        });
+
+        // keep the vertices still without a component
+        vector<int> left;
+        for (int v : remaining)
+        {
+            if (remains(v))
+                left.push_back(v);
         }
+        remaining.swap(left);
     }
 
-    // build the components map
-    int compNum = 0, lastPostTime = postTimes[ordering.front()] - 1;
-    while (!ordering.empty())
+    // number the components in order of their smallest vertex
+    components.assign(size, -1);
+    vector<int> number(size, -1);
+    int componentNum = 0;
+    for (int v = 0; v < size; ++v)
     {
-        // grab the current vertex
-        int currVertex = ordering.front();
-        if (lastPostTime == postTimes[currVertex] - 1)
-        {
-            components[currVertex] = compNum;
-        }
-        else {
-            components[currVertex] = ++compNum;
-        }
-        // increment the last post time
-        lastPostTime = postTimes[currVertex];
-        ordering.pop_front();
+        int c = comp[v].load(memory_order_relaxed);
+        if (number[c] == -1)
+            number[c] = componentNum++;
+        components[v] = number[c];
     }
+    return componentNum;
 }
 
 //----------------------------------------------------------------------
@@ -612,81 +1598,63 @@ void Graph::strongly_connected_components(Map& components) const
 //   none
 // Outputs:
 //   reduced_graph -- the reduced edges are added to the reduced graph
+//
+// Each strongly connected component becomes a cycle through its
+// vertices, and the components are joined by the reduction of the
+// condensation, found with a reachability bitset per component.
 //----------------------------------------------------------------------
 void Graph::transitive_reduction(Graph& reduced_graph) const
 {
-    Map strongComps;
-    strongly_connected_components(strongComps);
-
-    // make a list of a single vertex from each SCC
-    list<int> basicComps;
-
-    // keep track
-    int lastComp = -1, firstVertex = -1, lastVertex = -1, index = 0;
+    Condensation dag;
+    condensation(dag);
+    int count = dag.component_count();
+    Edges edges;
 
-    // build the reduced graph with the SCC first
-    for (Map::iterator it = strongComps.begin(); it != strongComps.end(); ++it)
+    // a cycle through the vertices of each component
+    for (int c = 0; c < count; c++)
     {
-        // keep track of how many vertices were looked at
-        index++;
-        // grab the current vertex and the component
-        int currVertex = it -> first;
-        int currComp = it -> second;
-
-        if (currComp == lastComp)
+        int first = dag.member_offsets[c];
+        int last = dag.member_offsets[c + 1] - 1;
+        for (int k = first; k < last; k++)
         {
-            // set the new edge
-            reduced_graph.set_edge(lastVertex, 0, currVertex);
-            // increment the last vertex
-            lastVertex = currVertex;
-
-            // check for last vertex in the map
-            if (index == vertex_count())
-            {
-                reduced_graph.set_edge(currVertex, 0, firstVertex);
-            }
+            edges.push_back(make_tuple(dag.members[k], 0, dag.members[k + 1]));
         }
-        else {
-            basicComps.push_back(currVertex);
-            // make sure its not the first vertex in the map
-            if (lastComp != -1 && lastVertex != firstVertex)
-            {
-                reduced_graph.set_edge(lastVertex, 0, firstVertex);
-            } 
-            // on a new component so increment last component and the first vertex
-            lastComp = currComp;
-            firstVertex = currVertex;
-            lastVertex = currVertex;
+        if (last > first)
+        {
+            edges.push_back(make_tuple(dag.members[last], 0, dag.members[first]));
         }
     }
 
-    // connect the basic cycles together
-    while (!basicComps.empty())
+    // reach holds a bit per component for each component, set if the
+    // component can be reached from it (including itself)
+    long words = (count + 63) / 64;
+    vector<uint64_t> reach(count * words, 0);
+
+    // components are in topological order, so going backward each
+    // component's targets are done before it. A target is kept only if
+    // no earlier (in topological order) target reaches it.
+    for (int c = count - 1; c >= 0; c--)
     {
-        int currVertex = basicComps.front();
-        for (int i = 0; i < vertex_count(); i++)
+        uint64_t* cover = &reach[c * words];
+        for (int k = dag.offsets[c]; k < dag.offsets[c + 1]; k++)
         {
-            // dont add more edges between vertices in the same SCC
-            if (strongComps[currVertex] != strongComps[i])
+            int d = dag.targets[k];
+            if (cover[d / 64] >> (d % 64) & 1)
             {
-                list<int> shortestPath, shortestPathReduced;
-                shortest_path_length(true, currVertex, i, shortestPath);
-                reduced_graph.shortest_path_length(true, currVertex, i, shortestPathReduced);
-                
-                // shortest path returns size 1 if the destination cannot be reached
-                // check if the edge needs to be on the reduced graph
-                if(shortestPath.size() != 1 && currVertex != i && shortestPathReduced.size() == 1)
-                {
-                    // add the edge to the reduced graph if the two vertices are connected in the original graph
-                    reduced_graph.set_edge(currVertex, 0, i);
-                    shortestPath.clear();
-                }
-                shortestPathReduced.clear();
+                continue;
+            }
+            edges.push_back(make_tuple(dag.members[dag.member_offsets[c]], 0,
+                                       dag.members[dag.member_offsets[d]]));
+            const uint64_t* from = &reach[d * words];
+            for (long w = 0; w < words; w++)
+            {
+                cover[w] |= from[w];
             }
-            
         }
-        basicComps.pop_front();
+        cover[c / 64] |= (uint64_t) 1 << (c % 64);
     }
+
+    reduced_graph.set_edges(edges);
 }
 
 //----------------------------------------------------------------------
@@ -702,19 +1670,21 @@ void Graph::transitive_reduction(Graph& reduced_graph) const
 //----------------------------------------------------------------------
 bool Graph::directed_eulerian_path(std::list<int>& path) const
 {
-    int edgesLeft[vertex_count()];
-    int sourceVertex = 0, sinkVertex = 0;
+    int size = vertex_count();
+    int sourceVertex = 0;
     // keep track of the number of sinks, sources, and the vertices with the same number of in and out edges
     int numOfSinks = 0, numOfSrcs = 0, numOfNormEdges = 0;
-    for (int i = 0; i < vertex_count(); i++)
+
+    // the out edges of vertex i are targets[offsets[i]] to
+    // targets[offsets[i+1]-1], copied once so each is used in turn
+    vector<int> offsets(size + 1, 0), targets;
+    for (int i = 0; i < size; i++)
     {
-        list<int> vertices;
-        connected_to(i, vertices);
-        int outEdges = vertices.size();
-        vertices.clear();
-        connected_from(i, vertices);
-        int inEdges = vertices.size();
-        edgesLeft[i] = outEdges;
+        int inEdges = 0;
+        for_each_connected_to(i, [&](int v, int) { targets.push_back(v); });
+        for_each_connected_from(i, [&](int, int) { inEdges++; });
+        offsets[i + 1] = targets.size();
+        int outEdges = offsets[i + 1] - offsets[i];
 
         // sort the vertices based on their edge counts
         if(outEdges == inEdges + 1)
@@ -724,7 +1694,6 @@ bool Graph::directed_eulerian_path(std::list<int>& path) const
         }
         else if (inEdges == outEdges + 1)
         {
-            sinkVertex == i;
             numOfSinks++;
         }
         else if (inEdges == outEdges)
@@ -736,12 +1705,11 @@ bool Graph::directed_eulerian_path(std::list<int>& path) const
     // at most one vertex has one less in-edge than out-edge (a “source”)
     // at most one vertex has one less out-edge than in-edge (a “sink”)
     // all other vertices have the same number of in-edges and out-edges
-    if (numOfNormEdges != vertex_count() - numOfSinks - numOfSrcs || numOfSinks > 1 || numOfSrcs > 1)
+    if (numOfNormEdges != size - numOfSinks - numOfSrcs || numOfSinks > 1 || numOfSrcs > 1)
         return false;
 
-
-    // keep track of the edges used up
-    Map edgesUsed;
+    // next[u] is the position of the first unused out edge of u
+    vector<int> next(offsets.begin(), offsets.end() - 1);
 
     stack<int> s;
     s.push(sourceVertex);
@@ -751,43 +1719,13 @@ bool Graph::directed_eulerian_path(std::list<int>& path) const
         int u = s.top();
 
         // add the vertex if its a dead end
-        if (edgesLeft[u] == 0)
+        if (next[u] == offsets[u + 1])
         {
             path.push_front(u);
             s.pop();
-        // else traverse the graph
+        // else follow the next unused edge
         } else {
-            list<int> vertices;
-
-            connected_to(u, vertices);
-            bool foundVertex = false;
-
-            for (list<int>::iterator it = vertices.begin(); it != vertices.end(); ++it)
-            {
-                // current vertex
-                int v = *it;
-                bool hasEdgeBeenUsed = false;
-
-                // check if the edge has been used before
-                for (Map::iterator it = edgesUsed.begin(); it != edgesUsed.end(); ++it)
-                {
-                    if (u == it -> first && v == it -> second)
-                    {
-                        hasEdgeBeenUsed = true;
-                        break;
-                    }
-                }
-
-                // add the vertex to the stack and mark it as used
-                if (!hasEdgeBeenUsed)
-                {
-                    edgesUsed[u] = v;
-                    edgesLeft[u]--;
-                    s.push(v);
-                    foundVertex = true;
-                    break;
-                }
-            }
+            s.push(targets[next[u]++]);
         }
     }
 
@@ -845,100 +1783,82 @@ bool Graph::directed_hamiltonian_path(std::list<int>& path) const
 //----------------------------------------------------------------------
 bool Graph::bipartite_graph_matching(Graph& max_matched_graph) const
 {    
-    Map coloring;
+    vector<int> coloring;
     // return false if the graph is not bipartite
     if(!bipartite_graph(coloring)) 
         return false;
-    
-    // init the labels
-    int labels[vertex_count()];
-    for(int v = 0; v < vertex_count(); v++) 
-        labels[v] = -1;
 
-    list<int> V, U;
-    queue<int> q;
+    int n = vertex_count();
 
-    for(auto p : coloring) 
-    {
-        if(p.second == 0) 
-            V.push_back(p.first);
-        else 
-            U.push_back(p.first);
-    }
+    // the vertex each vertex is matched to (-1 if free), and the V
+    // vertex each U vertex was reached from in the current search
+    vector<int> mate(n, -1);
+    vector<int> labels(n);
+    vector<bool> reached(n);
+    vector<int> q;
+    q.reserve(n);
 
-    // put all the vertices from V into the queue
-    for(int v : V) 
-        q.push(v);
-    
-    while(!q.empty()) 
+    // search for an augmenting path from the free V (color 0) vertices
+    // until there are none left
+    bool augmented = true;
+    while(augmented) 
     {
-        int w = q.front(); 
-        q.pop();
-        bool inV = false;
-
-        for(int v : V)
+        augmented = false;
+        fill(labels.begin(), labels.end(), -1);
+        fill(reached.begin(), reached.end(), false);
+        q.clear();
+        for(int v = 0; v < n; v++) 
         {
-            if(w == v) 
+            if(coloring[v] == 0 && mate[v] == -1) 
             {
-                inV=true; 
-                break;
+                reached[v] = true;
+                q.push_back(v);
             }
         }
 
-        // if w is in the V list 
-        if(inV) {
-            list<int> vertices;
-            adjacent(w, vertices);
-
-            for(int u : vertices) 
-            {
-                list<int> adj;
-                max_matched_graph.adjacent(u, adj);
-                // check if u is free
-                if(adj.empty()) 
+        for(int front = 0; front < (int) q.size() && !augmented; front++) 
+        {
+            int w = q[front];
+            int freeVertex = -1;
+            // alternate from w over an unmatched edge to u, and from a
+            // matched u on to its mate
+            any_adjacent(w, [&](int u, int) {
+                if(labels[u] != -1 || mate[w] == u) 
+                    return false;
+                labels[u] = w;
+                if(mate[u] == -1) 
                 {
-                    max_matched_graph.set_edge(w, 0, u);
-                    int v = w;
-
-                    while(labels[v] != -1) 
-                    {
-                        u = labels[v];
-                        max_matched_graph.remove_edge(v, u);
-                        v = labels[u];
-                        max_matched_graph.set_edge(v, 0, u);
-                    }
-
-                    // reset the labels
-                    for(int i = 0; i < vertex_count(); i++) 
-                        labels[i] = -1;
-
-                    for(int v : V) 
-                    {
-                        list<int> adj;
-                        max_matched_graph.adjacent(v, adj);
-                        if(adj.size() == 0) q.push(v);
-                    } 
-                    break;
-                // u is matched
-                } else {                                                                                                                                                              
-                    if(!max_matched_graph.has_edge(w,u) && labels[u] == -1) 
-                    {
-                        labels[u] = w;
-                        q.push(u);
-                    }
+                    freeVertex = u;
+                    return true;
                 }
+                if(!reached[mate[u]]) 
+                {
+                    reached[mate[u]] = true;
+                    q.push_back(mate[u]);
+                }
+                return false;
+            });
+
+            // flip the edges along the path back to the free V vertex
+            int u = freeVertex;
+            while(u != -1) 
+            {
+                int v = labels[u];
+                int next = mate[v];
+                mate[u] = v;
+                mate[v] = u;
+                u = next;
+                augmented = true;
             }
-        // w in U and matched   
-        } else {                                                                                                                                                         
-            list<int> vertices;
-            max_matched_graph.adjacent(w, vertices);
-            int v;
-            if(vertices.size() == 1) 
-                v = vertices.front();
-            labels[v] = w;
-            q.push(v);
         }
     }
+
+    // add the matched edges from V to U
+    for(int v = 0; v < n; v++) 
+    {
+        if(coloring[v] == 0 && mate[v] != -1) 
+            max_matched_graph.set_edge(v, 0, mate[v]);
+    }
     return true;
 }
 
@@ -971,12 +1891,8 @@ bool Graph::directed_hamiltonian_rec(int v, std::list<int>& path, bool discovere
     {
         return true;
     } else {
-        list<int> vertices;
-        connected_to(v, vertices);
-
-        for (list<int>::iterator it = vertices.begin(); it != vertices.end(); ++it)
-        {
-            int u = *it;
+        // stop visiting the out edges once a path is found
+        return any_connected_to(v, [&](int u, int) {
             if (!discovered[u])
             {
                 discovered[u] = true;
@@ -985,12 +1901,14 @@ bool Graph::directed_hamiltonian_rec(int v, std::list<int>& path, bool discovere
                 {
                     return true;
                 } else {
+                    // backtrack so u can be used later in the path
                     path.remove(u);
+                    discovered[u] = false;
                 }
             }
-        }
+            return false;
+        });
     }
-    return false;
 }
 
 // helper function for finding all cliques
@@ -1006,9 +1924,8 @@ void Graph::cliques_rec(Set& p, Set& r, Set& x, std::list<Set>& cliques) const
         for (Set::iterator it = p.begin(); it != p.end(); ++it)
         {
             int v = *it;
-            list<int> adjVertices;
-            adjacent(v, adjVertices);
-            Set adj(adjVertices.begin(), adjVertices.end());
+            Set adj;
+            for_each_adjacent(v, [&](int u, int) { adj.insert(u); });
 
             list<int> tmp;
             set_intersection(pCopy.begin(), pCopy.end(), adj.begin(), adj.end(), back_inserter(tmp));
@@ -1050,14 +1967,27 @@ void Graph::cliques_rec(Set& p, Set& r, Set& x, std::list<Set>& cliques) const
 //----------------------------------------------------------------------
 void Graph::dijkstra_shortest_path(int src, Map &path_costs) const
 {
-    bool excluded[vertex_count()] = {false};
-    excluded[src] = true;
+    vector<int> costs;
+    dijkstra_shortest_path(src, costs);
+    copy_values(costs, path_costs);
+}
+
+//----------------------------------------------------------------------
+// Dijkstra's algorithm that fills a dense path cost array.
+//
+// Output:
+//  path_costs -- path_costs[v] is the minimum path cost from src to
+//                v (numeric_limits<int>::max() if not reachable)
+//----------------------------------------------------------------------
+void Graph::dijkstra_shortest_path(int src, std::vector<int> &path_costs) const
+{
     // set all the path costs to infinity
-    for (int v = 0; v < vertex_count(); v++)
-    {
-        path_costs[v] = numeric_limits<int>::max();
-    }
+    path_costs.assign(vertex_count(), numeric_limits<int>::max());
+    if (src < 0 || src >= vertex_count())
+        return;
 
+    vector<bool> excluded(vertex_count(), false);
+    excluded[src] = true;
     path_costs[src] = 0;
 
     bool edgeFound = true;
@@ -1072,19 +2002,17 @@ void Graph::dijkstra_shortest_path(int src, Map &path_costs) const
         {
             if (excluded[u])
             {
-                for (int v = 0; v < vertex_count(); v++)
-                {
-                    int cost;
-                    get_edge(u, v, cost);
-                    if (!excluded[v] && has_edge(u,v) && (!edgeFound || cost + path_costs[u] < min))
+                int uCost = path_costs[u];
+                for_each_connected_to(u, [&](int v, int cost) {
+                    if (!excluded[v] && (!edgeFound || cost + uCost < min))
                     {
                         // set the new min and update the vPrime and uPrime
-                        min = cost + path_costs[u];
+                        min = cost + uCost;
                         edgeFound = true;
                         uPrime = u;
                         vPrime = v;
                     }
-                }
+                });
             }
         }
         // if new edge found
@@ -1124,23 +2052,15 @@ void Graph::prim_min_spanning_tree(Graph &spanning_tree) const
         {
             if (excluded[u])
             {
-                for (int v = 0; v < vertex_count(); v++)
-                {
-                    if (!excluded[v])
+                // compare the cost of each edge to the old minimum
+                for_each_connected_to(u, [&](int v, int edgeCost) {
+                    if (!excluded[v] && edgeCost < minCost)
                     {
-                        // if there is an edge get the cost and compare to the old minimum
-                        int edgeCost;
-                        if (get_edge(u, v, edgeCost))
-                        {
-                            if (edgeCost < minCost)
-                            {
-                                minCost = edgeCost;
-                                u1 = u;
-                                v1 = v;
-                            }
-                        }
+                        minCost = edgeCost;
+                        u1 = u;
+                        v1 = v;
                     }
-                }
+                });
             }
         }
 
@@ -1178,16 +2098,11 @@ void Graph::kruskal_min_spanning_tree(Graph &spanning_tree) const
 {
     Edges edges;
 
-    for (int v = 0; v < vertex_count(); v++)
+    for (int u = 0; u < vertex_count(); u++)
     {
-        for (int u = 0; u < vertex_count(); u++)
-        {
-            int cost;
-            if (get_edge(u, v, cost))
-            {
-                edges.push_back(tuple<int, int, int>(u, cost, v));
-            }
-        }
+        for_each_connected_to(u, [&](int v, int cost) {
+            edges.push_back(tuple<int, int, int>(u, cost, v));
+        });
     }
 
     edge_sort(edges, 0, edges.size() - 1);
@@ -1283,41 +2198,59 @@ void Graph::edge_sort(Edges& edges, int start, int end) const
 //          otherwise
 //----------------------------------------------------------------------
 bool Graph::bellman_ford_shortest_path(int src, Map &path_costs) const
+{
+    vector<int> costs;
+    bool noNegativeCycle = bellman_ford_shortest_path(src, costs);
+    copy_values(costs, path_costs);
+    return noNegativeCycle;
+}
+
+//----------------------------------------------------------------------
+// Bellman-Ford's algorithm that fills a dense path cost array.
+//
+// Output:
+//  path_costs -- path_costs[v] is the minimum path cost from src to
+//                v (numeric_limits<int>::max() if not reachable)
+//
+// Returns: true if there is not a negative cycle, and false
+//          otherwise
+//----------------------------------------------------------------------
+bool Graph::bellman_ford_shortest_path(int src, std::vector<int> &path_costs) const
 {
     int INT_MAX = numeric_limits<int>::max();
     // set all the path costs to infinity
-    for (int v = 0; v < vertex_count(); v++)
-    {
-        path_costs[v] = INT_MAX;
-    }
+    path_costs.assign(vertex_count(), INT_MAX);
+    if (src < 0 || src >= vertex_count())
+        return true;
     path_costs[src] = 0;
 
     for (int i = 0; i < vertex_count() - 1; i++)
     {
         for (int u = 0; u < vertex_count(); u++)
         {
-            for (int v = 0; v < vertex_count(); v++)
-            {
-                int cost;
-                if (get_edge(u, v, cost) && path_costs[u] != INT_MAX && path_costs[u] + cost < path_costs[v])
+            if (path_costs[u] == INT_MAX)
+                continue;
+            for_each_connected_to(u, [&](int v, int cost) {
+                if (path_costs[u] + cost < path_costs[v])
                 {
                     path_costs[v] = path_costs[u] + cost;
                 }
-            }
+            });
         }
     }
 
     // check for negative cycles
+    bool negativeCycle = false;
     for (int u = 0; u < vertex_count(); u++)
         {
-            for (int v = 0; v < vertex_count(); v++)
-            {
-                int cost;
-                if (get_edge(u, v, cost) && path_costs[u] + cost < path_costs[v])
+            for_each_connected_to(u, [&](int v, int cost) {
+                if (path_costs[u] + cost < path_costs[v])
                 {
-                    return false;
+                    negativeCycle = true;
                 }
-            }
+            });
+            if (negativeCycle)
+                return false;
         }
 
     return true;
@@ -1353,17 +2286,17 @@ bool Graph::path_max_independent_set(int vertex_weights[], Set &S) const
         foundEndCF = false;
         foundEndCT = false;
         
-        list<int> ct, cf;
-        connected_to(i, ct);
-        connected_from(i, cf);
+        int ct = 0, cf = 0;
+        for_each_connected_to(i, [&](int, int) { ct++; });
+        for_each_connected_from(i, [&](int, int) { cf++; });
 
-        if (ct.size() > 1 || cf.size() > 1)
+        if (ct > 1 || cf > 1)
         {
             // no path graph
             return false;
         }
 
-        if (ct.size() == 0)
+        if (ct == 0)
         {
             // check for end of the path
             if (foundEndCT)
@@ -1375,7 +2308,7 @@ bool Graph::path_max_independent_set(int vertex_weights[], Set &S) const
             foundEndCT = true;
         }
 
-        if (cf.size() == 0)
+        if (cf == 0)
         {
             // check for start of the path
             if (foundEndCF)
@@ -1438,20 +2371,15 @@ bool Graph::all_pairs_shortest_paths(std::vector<std::vector<int>> &weights) con
     {
         for (int v = 0; v < V; v++)
         {
-            int edge;
-            if (u == v)
-            {
-                A[0][u][v] = 0;
-            }
-            else if (get_edge(u, v, edge))
-            {
-                A[0][u][v] = edge;
-            }
-            else
+            A[0][u][v] = (u == v) ? 0 : MAX;
+        }
+        int* row = A[0][u];
+        for_each_connected_to(u, [&](int v, int edge) {
+            if (u != v)
             {
-                A[0][u][v] = MAX;
+                row[v] = edge;
             }
-        }
+        });
     }
 
     for (int k = 2; k < V + 1; k++)
@@ -1494,4 +2422,4 @@ bool Graph::all_pairs_shortest_paths(std::vector<std::vector<int>> &weights) con
         weights.push_back(temp);
     }
     return true;
-}
\ No newline at end of file
+}
\ No newline at end of file
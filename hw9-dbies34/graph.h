@@ -20,6 +20,71 @@ typedef std::unordered_map<int,int> Map;
 typedef std::set<int> Set;
 typedef std::vector<std::tuple<int, int, int>> Edges;
 
+// the directed acyclic graph of the strongly connected components of a
+// graph, where each component is collapsed to a single vertex
+struct Condensation
+{
+  // components[v] is the component of vertex v, where components are
+  // numbered from 0 to c-1 in topological order (so each edge goes
+  // from a lower to a higher component)
+  std::vector<int> components;
+
+  // the vertices of component i are members[member_offsets[i]] to
+  // members[member_offsets[i+1]-1], in increasing order
+  std::vector<int> member_offsets;
+  std::vector<int> members;
+
+  // the edges i->j between different components, where the j of
+  // component i are targets[offsets[i]] to targets[offsets[i+1]-1],
+  // in increasing order and without repeats
+  std::vector<int> offsets;
+  std::vector<int> targets;
+
+  // number of components
+  int component_count() const { return (int) offsets.size() - 1; }
+};
+
+class BitAdjacencyMatrix;
+
+// callback used to visit the edges of a vertex without copying them
+// into a list
+class EdgeVisitor
+{
+public:
+
+  // default destructor
+  virtual ~EdgeVisitor() {};
+
+  // called with the other vertex and the label of each edge, returns
+  // false to stop visiting the remaining edges
+  virtual bool visit(int vertex, int edge_label) = 0;
+};
+
+// callback used to follow the edges added to and removed from a graph
+// (see Graph::add_listener)
+class EdgeListener
+{
+public:
+
+  // default destructor
+  virtual ~EdgeListener() {};
+
+  // called after a new edge v1->v2 is added (updating the label of an
+  // existing edge is not reported)
+  virtual void edge_added(int v1, int v2) = 0;
+
+  // called after the edge v1->v2 is removed
+  virtual void edge_removed(int v1, int v2) = 0;
+
+  // called after the graph is assigned to, when its vertex count and
+  // any of its edges may have changed
+  virtual void graph_assigned() {}
+
+  // called before a new edge v1->v2 is added, where returning false
+  // keeps the edge out of the graph (and no listener is told of it)
+  virtual bool allow_edge(int, int) { return true; }
+};
+
 class Graph
 {
 public:
@@ -50,12 +115,92 @@ public:
   // from the vertex (may return duplicate vertices)
   virtual void adjacent(int v, std::list<int>& vertices) const = 0;
 
+  // add or update each (v1, edge_label, v2) edge in the batch, which
+  // is the same as calling set_edge on each edge in order
+  virtual void set_edges(const Edges& edges);
+
+  // report each edge added by set_edge or set_edges and each edge
+  // removed by remove_edge to the listener (until it is removed), where
+  // the listener is not copied with the graph and assigning the graph
+  // is reported through graph_assigned
+  void add_listener(EdgeListener* listener);
+
+  // stop reporting edge changes to the listener
+  void remove_listener(EdgeListener* listener);
+
   // get number of nodes in the graph
   virtual int vertex_count() const = 0; 
 
   // get number of edges in the graph
   virtual int edge_count() const = 0; 
 
+  // visit each outgoing edge of the given vertex, returns false if
+  // the visitor stopped early
+  virtual bool visit_connected_to(int v1, EdgeVisitor& visitor) const = 0;
+
+  // visit each incoming edge of the given vertex, returns false if the
+  // visitor stopped early
+  virtual bool visit_connected_from(int v2, EdgeVisitor& visitor) const = 0;
+
+  // visit each outgoing and then each incoming edge of the given
+  // vertex (may visit a vertex twice), returns false if the visitor
+  // stopped early
+  bool visit_adjacent(int v, EdgeVisitor& visitor) const;
+
+  // call f(vertex, edge_label) for each outgoing edge of the vertex
+  template<typename F>
+  void for_each_connected_to(int v1, F f) const;
+
+  // call f(vertex, edge_label) for each incoming edge of the vertex
+  template<typename F>
+  void for_each_connected_from(int v2, F f) const;
+
+  // call f(vertex, edge_label) for each adjacent edge of the vertex
+  template<typename F>
+  void for_each_adjacent(int v, F f) const;
+
+  // call f(vertex, edge_label) for each outgoing edge of the vertex if
+  // dir is true, otherwise for each adjacent edge
+  template<typename F>
+  void for_each_neighbor(bool dir, int v, F f) const;
+
+  // returns true as soon as pred(vertex, edge_label) is true for an
+  // outgoing edge of the vertex (the remaining edges are not visited)
+  template<typename F>
+  bool any_connected_to(int v1, F pred) const;
+
+  // returns true as soon as pred(vertex, edge_label) is true for an
+  // incoming edge of the vertex (the remaining edges are not visited)
+  template<typename F>
+  bool any_connected_from(int v2, F pred) const;
+
+  // returns true as soon as pred(vertex, edge_label) is true for an
+  // adjacent edge of the vertex (the remaining edges are not visited)
+  template<typename F>
+  bool any_adjacent(int v, F pred) const;
+
+  // the edges a search follows from each vertex: outgoing edges,
+  // incoming edges (searching the reversed graph), or both
+  enum SearchEdges { OUT_EDGES, IN_EDGES, ALL_EDGES };
+
+  // Iterative depth-first search from src over the given edges, where
+  // each edge is examined exactly once. Each vertex keeps a cursor into
+  // its neighbors (gathered once into a shared buffer when the vertex
+  // is discovered), so the search resumes where it left off instead of
+  // rescanning the neighbors. Vertices already marked in discovered
+  // are not entered, so a search over many sources can share it.
+  //
+  //   pre(v, parent) -- called when v is discovered (parent is -1 for
+  //                     src)
+  //   edge(u, v)     -- called for each edge u->v to an already
+  //                     discovered v, returns false to stop the search
+  //   post(v)        -- called once each edge of v has been examined
+  //
+  // Returns false if the search was stopped by edge, true otherwise.
+  template<typename Pre, typename Edge, typename Post>
+  bool depth_first_search(SearchEdges edges, int src, std::vector<bool>& discovered,
+                          Pre pre, Edge edge, Post post) const;
+
   
   //----------------------------------------------------------------------
   // HW-3 graph operations
@@ -72,9 +217,85 @@ public:
   //           source to their parent vertices
   //----------------------------------------------------------------------
   void bfs(bool dir, int src, Map& tree) const;
+
+  //----------------------------------------------------------------------
+  // Breadth-first search that fills a dense parent array.
+  //
+  // Outputs:
+  //   tree -- tree[v] is the parent of v in the search tree, or -1 for
+  //           the source and vertices not found (size vertex_count())
+  //----------------------------------------------------------------------
+  void bfs(bool dir, int src, std::vector<int>& tree) const;
+
+  //----------------------------------------------------------------------
+  // Direction-optimizing breadth-first search from a given source
+  // vertex. Levels with a small frontier are expanded top-down from the
+  // frontier, and levels with a large frontier bottom-up, where each
+  // vertex not yet found looks for a parent in the frontier (stopping
+  // at the first one). The frontier and found vertices are kept as
+  // bitmaps for the bottom-up levels.
+  //
+  // Inputs:
+  //   dir -- true if directed
+  //   src -- the source vertex
+  // Outputs:
+  //   tree -- search tree that maps vertices found from the source to
+  //           their parent vertices (a parent may differ from bfs, but
+  //           is always one level closer to the source)
+  //----------------------------------------------------------------------
+  void direction_optimizing_bfs(bool dir, int src, Map& tree) const;
+
+  //----------------------------------------------------------------------
+  // Direction-optimizing breadth-first search that fills a dense
+  // parent array (-1 for the source and vertices not found).
+  //----------------------------------------------------------------------
+  void direction_optimizing_bfs(bool dir, int src, std::vector<int>& tree) const;
+
+  //----------------------------------------------------------------------
+  // Parallel level-synchronous breadth-first search from a given source
+  // vertex. Each frontier is split across threads (see parallel.h),
+  // where a vertex is claimed by the first thread to set its parent
+  // and each thread collects its part of the next frontier separately.
+  //
+  // Inputs:
+  //   dir -- true if directed
+  //   src -- the source vertex
+  // Outputs:
+  //   tree -- search tree that maps vertices found from the source to
+  //           their parent vertices (a parent may differ from bfs, but
+  //           is always one level closer to the source)
+  //----------------------------------------------------------------------
+  void parallel_bfs(bool dir, int src, Map& tree) const;
+
+  //----------------------------------------------------------------------
+  // Parallel breadth-first search that fills a dense parent array (-1
+  // for the source and vertices not found).
+  //----------------------------------------------------------------------
+  void parallel_bfs(bool dir, int src, std::vector<int>& tree) const;
+
+  //----------------------------------------------------------------------
+  // Breadth-first search from many sources at once. Sources are run in
+  // batches of 64, where each vertex keeps one bit per source of the
+  // batch in a 64-bit word, so that a single pass over the edges of a
+  // vertex advances every search of the batch that reached it. Batches
+  // are split across threads (see parallel.h).
+  //
+  // Inputs:
+  //   dir     -- true if directed
+  //   sources -- the source vertices (may repeat)
+  // Outputs:
+  //   distances -- distances[i][v] is the number of edges on a
+  //                shortest path from sources[i] to v, or -1 if v
+  //                cannot be reached (one row per source)
+  //----------------------------------------------------------------------
+  void multi_source_bfs(bool dir, const std::vector<int>& sources,
+                        std::vector<std::vector<int>>& distances) const;
   
   //----------------------------------------------------------------------
-  // Shortest path length from source to destination vertices.
+  // Shortest path length from source to destination vertices. Searches
+  // forward from the source and backward from the destination, one
+  // level of the smaller frontier at a time, and stops once the two
+  // searches meet.
   //
   // Conditions:
   //   The source and destination vertices must be unique.  
@@ -102,6 +323,47 @@ public:
   //----------------------------------------------------------------------
   void bfs_connected_components(Map& components) const;
 
+  //----------------------------------------------------------------------
+  // Connected components as a dense array.
+  //
+  // Outputs:
+  //   components -- components[v] is the component number of v
+  //   returns    -- the number of components c
+  //----------------------------------------------------------------------
+  int bfs_connected_components(std::vector<int>& components) const;
+
+  //----------------------------------------------------------------------
+  // Find connected components by joining the ends of each edge in a
+  // union-find (see union_find.h), in O(V + E) time.
+  //
+  // Conditions:
+  //   Finds weakly-connected components in a directed graph.
+  // Outputs:
+  //   components -- components[v] is the component number of v, where
+  //                 components are numbered from 0 to c-1 in order of
+  //                 their smallest vertex (as bfs_connected_components)
+  //   returns    -- the number of components c
+  //----------------------------------------------------------------------
+  int union_find_connected_components(std::vector<int>& components) const;
+
+  //----------------------------------------------------------------------
+  // Find connected components in parallel using Afforest. Each vertex
+  // is first linked to a couple of its neighbors, which usually puts
+  // most of the graph in one large component. The edges of vertices
+  // outside of that component are then linked, skipping the rest.
+  // Links hook the larger of two component ids under the smaller
+  // with an atomic compare-and-swap (as in Shiloach-Vishkin).
+  //
+  // Conditions:
+  //   Finds weakly-connected components in a directed graph.
+  // Outputs:
+  //   components -- components[v] is the component number of v, where
+  //                 components are numbered from 0 to c-1 in order of
+  //                 their smallest vertex (as bfs_connected_components)
+  //   returns    -- the number of components c
+  //----------------------------------------------------------------------
+  int parallel_connected_components(std::vector<int>& components) const;
+
   //----------------------------------------------------------------------
   // Determine if the graph is bipartite (i.e., 2-colorable)
   //
@@ -114,6 +376,33 @@ public:
   //----------------------------------------------------------------------
   bool bipartite_graph(Map& coloring) const;
 
+  //----------------------------------------------------------------------
+  // Bipartite test that fills a dense coloring array.
+  //
+  // Outputs:
+  //   returns  -- true if the graph is bipartite, false otherwise
+  //   coloring -- coloring[v] is the color (either 0 or 1) of v if the
+  //               graph is bipartite
+  //----------------------------------------------------------------------
+  bool bipartite_graph(std::vector<int>& coloring) const;
+
+  //----------------------------------------------------------------------
+  // Bipartite test that also finds an odd cycle when the graph is not
+  // bipartite. Runs in O(V + E), coloring each component by
+  // breadth-first search, where components are colored in parallel
+  // on large graphs (see parallel.h).
+  //
+  // Outputs:
+  //   returns   -- true if the graph is bipartite, false otherwise
+  //   coloring  -- coloring[v] is the color (either 0 or 1) of v if the
+  //                graph is bipartite, where the smallest vertex of each
+  //                component has color 1
+  //   odd_cycle -- if the graph is not bipartite, the vertices of an
+  //                odd cycle in order (ignoring edge direction), where
+  //                the last vertex is adjacent to the first
+  //----------------------------------------------------------------------
+  bool bipartite_graph(std::vector<int>& coloring, std::vector<int>& odd_cycle) const;
+
 
   //----------------------------------------------------------------------
   // HW-4 graph operations
@@ -131,6 +420,15 @@ public:
   //----------------------------------------------------------------------
   void dfs(bool dir, int src, Map& tree) const;
 
+  //----------------------------------------------------------------------
+  // Depth-first search that fills a dense parent array.
+  //
+  // Outputs:
+  //   tree -- tree[v] is the parent of v in the search tree, or -1 for
+  //           the source and vertices not found (size vertex_count())
+  //----------------------------------------------------------------------
+  void dfs(bool dir, int src, std::vector<int>& tree) const;
+
   //----------------------------------------------------------------------
   // Determine if the graph is acyclic or not.
   //
@@ -156,6 +454,23 @@ public:
   //----------------------------------------------------------------------
   void unweighted_transitive_closure(bool dir, Graph& closed_graph) const;
 
+  //----------------------------------------------------------------------
+  // Computes the transitive closure of the current (directed) graph as
+  // a bit matrix. Reachability is found per strongly connected
+  // component, a row of 64-bit words each, in reverse topological
+  // order, with the components of each level of the condensation done
+  // in parallel.
+  //
+  // Conditions: Assumes that the given matrix has the same number of
+  //             nodes as the current graph and no edges prior to the
+  //             call
+  //
+  // Outputs:
+  //   closure -- has an edge i->v (with label 0) for each vertex v
+  //              other than i reachable from i
+  //----------------------------------------------------------------------
+  void bit_transitive_closure(BitAdjacencyMatrix& closure) const;
+
   //----------------------------------------------------------------------
   // Computes a topological sort of the current graph based on dfs.
   //
@@ -169,6 +484,15 @@ public:
   //                      are ordered from 1 to n)
   //----------------------------------------------------------------------
   void dfs_topological_sort(Map& vertex_ordering) const;
+
+  //----------------------------------------------------------------------
+  // Topological sort that fills a dense ordering array.
+  //
+  // Outputs:
+  //   vertex_ordering -- vertex_ordering[v] is the order of v in the
+  //                      topological sort (from 1 to n)
+  //----------------------------------------------------------------------
+  void dfs_topological_sort(std::vector<int>& vertex_ordering) const;
   
 
   //----------------------------------------------------------------------
@@ -187,6 +511,47 @@ public:
   //----------------------------------------------------------------------
   void strongly_connected_components(Map& components) const;
 
+  //----------------------------------------------------------------------
+  // Strongly connected components as a dense array, using Pearce's
+  // single pass, iterative version of Tarjan's algorithm in O(V + E).
+  //
+  // Outputs:
+  //   components -- components[v] is the component number of v, where
+  //                 components are numbered in topological order (as
+  //                 in Condensation)
+  //   returns    -- the number of components c
+  //----------------------------------------------------------------------
+  int strongly_connected_components(std::vector<int>& components) const;
+
+  //----------------------------------------------------------------------
+  // Computes the condensation of the graph, which is the graph of its
+  // strongly connected components.
+  //
+  // Outputs:
+  //   dag -- the components, their members, and the edges between them
+  //----------------------------------------------------------------------
+  void condensation(Condensation& dag) const;
+
+  //----------------------------------------------------------------------
+  // Computes the strongly connected components in parallel (see
+  // parallel.h). Vertices without an incoming or outgoing edge from
+  // another remaining vertex are first trimmed off as components of
+  // their own. The component of the vertex with the most edges is then
+  // found as the vertices both reachable from it and reaching it, by
+  // parallel searches over the outgoing and incoming edges. The rest
+  // are found by coloring, where the largest vertex reaching each
+  // vertex is spread along the edges, and each vertex that keeps its
+  // own color is the root of a component of the vertices of its color
+  // that reach it.
+  //
+  // Outputs:
+  //   components -- components[v] is the component number of v, where
+  //                 components are numbered from 0 to c-1 in order of
+  //                 their smallest vertex
+  //   returns    -- the number of components c
+  //----------------------------------------------------------------------
+  int parallel_strongly_connected_components(std::vector<int>& components) const;
+
   //----------------------------------------------------------------------
   // Computes the transitive reduction.
   //
@@ -280,6 +645,15 @@ public:
   //                given as path_costs[v].
   //----------------------------------------------------------------------
   void dijkstra_shortest_path(int src, Map& path_costs) const;
+
+  //----------------------------------------------------------------------
+  // Dijkstra's algorithm that fills a dense path cost array.
+  //
+  // Output:
+  //  path_costs -- path_costs[v] is the minimum path cost from src to
+  //                v (numeric_limits<int>::max() if not reachable)
+  //----------------------------------------------------------------------
+  void dijkstra_shortest_path(int src, std::vector<int>& path_costs) const;
   
   //----------------------------------------------------------------------
   // Compute a minimum spanning tree using Prim's algorithm.
@@ -335,6 +709,18 @@ public:
   //----------------------------------------------------------------------
   bool bellman_ford_shortest_path(int src, Map& path_costs) const;
 
+  //----------------------------------------------------------------------
+  // Bellman-Ford's algorithm that fills a dense path cost array.
+  //
+  // Output:
+  //  path_costs -- path_costs[v] is the minimum path cost from src to
+  //                v (numeric_limits<int>::max() if not reachable)
+  //
+  // Returns: true if there is not a negative cycle, and false
+  //          otherwise
+  //----------------------------------------------------------------------
+  bool bellman_ford_shortest_path(int src, std::vector<int>& path_costs) const;
+
 
   //----------------------------------------------------------------------
   // HW-9 graph operations
@@ -374,6 +760,31 @@ public:
   //----------------------------------------------------------------------
   bool all_pairs_shortest_paths(std::vector<std::vector<int>>& weights) const;
   
+protected:
+
+  // helper function for building graphs from a batch of edges that
+  // groups the in-bounds edges by v1 and orders each group by v2, where
+  // the edges of v1 are edges[order[offsets[v1]]] to
+  // edges[order[offsets[v1+1]-1]] and a repeated edge only keeps the
+  // last one given
+  static void group_edges(int vertex_count, const Edges& edges,
+                          std::vector<int>& offsets, std::vector<int>& order);
+
+  // the listeners edge changes are reported to
+  std::vector<EdgeListener*> listeners;
+
+  // check that each listener allows a new edge
+  bool allow_new_edge(int v1, int v2);
+
+  // report a new edge to each listener
+  void notify_edge_added(int v1, int v2);
+
+  // report a removed edge to each listener
+  void notify_edge_removed(int v1, int v2);
+
+  // report to each listener that the graph was assigned to
+  void notify_graph_assigned();
+
 private:
 
   // helper function for directed hamiltonian recursive function
@@ -389,4 +800,151 @@ private:
 };
 
 
+// wraps a function so that it can be used as an edge visitor
+template<typename F>
+class FunctionVisitor : public EdgeVisitor
+{
+public:
+
+  FunctionVisitor(F& f) : f(f) {};
+
+  bool visit(int vertex, int edge_label)
+  {
+    f(vertex, edge_label);
+    return true;
+  }
+
+private:
+
+  F& f;
+};
+
+// wraps a predicate so that visiting stops once it returns true
+template<typename F>
+class PredicateVisitor : public EdgeVisitor
+{
+public:
+
+  PredicateVisitor(F& pred) : pred(pred) {};
+
+  bool visit(int vertex, int edge_label)
+  {
+    return !pred(vertex, edge_label);
+  }
+
+private:
+
+  F& pred;
+};
+
+template<typename F>
+void Graph::for_each_connected_to(int v1, F f) const
+{
+  FunctionVisitor<F> visitor(f);
+  visit_connected_to(v1, visitor);
+}
+
+template<typename F>
+void Graph::for_each_connected_from(int v2, F f) const
+{
+  FunctionVisitor<F> visitor(f);
+  visit_connected_from(v2, visitor);
+}
+
+template<typename F>
+void Graph::for_each_adjacent(int v, F f) const
+{
+  FunctionVisitor<F> visitor(f);
+  visit_adjacent(v, visitor);
+}
+
+template<typename F>
+void Graph::for_each_neighbor(bool dir, int v, F f) const
+{
+  if (dir)
+    for_each_connected_to(v, f);
+  else
+    for_each_adjacent(v, f);
+}
+
+template<typename F>
+bool Graph::any_connected_to(int v1, F pred) const
+{
+  PredicateVisitor<F> visitor(pred);
+  return !visit_connected_to(v1, visitor);
+}
+
+template<typename F>
+bool Graph::any_connected_from(int v2, F pred) const
+{
+  PredicateVisitor<F> visitor(pred);
+  return !visit_connected_from(v2, visitor);
+}
+
+template<typename F>
+bool Graph::any_adjacent(int v, F pred) const
+{
+  PredicateVisitor<F> visitor(pred);
+  return !visit_adjacent(v, visitor);
+}
+
+template<typename Pre, typename Edge, typename Post>
+bool Graph::depth_first_search(SearchEdges edges, int src, std::vector<bool>& discovered,
+                               Pre pre, Edge edge, Post post) const
+{
+  if (src < 0 || src >= vertex_count() || discovered[src])
+    return true;
+
+  // the neighbors of each vertex on the stack, in stack order, where
+  // frame i has neighbors[next..end-1] left to examine
+  struct Frame
+  {
+    int vertex;
+    int first;
+    int next;
+    int end;
+  };
+  std::vector<int> neighbors;
+  std::vector<Frame> frames;
+
+  auto enter = [&](int v, int parent) {
+    discovered[v] = true;
+    pre(v, parent);
+    int first = neighbors.size();
+    auto gather = [&](int u, int) { neighbors.push_back(u); };
+    if (edges == OUT_EDGES)
+      for_each_connected_to(v, gather);
+    else if (edges == IN_EDGES)
+      for_each_connected_from(v, gather);
+    else
+      for_each_adjacent(v, gather);
+    frames.push_back({v, first, first, (int) neighbors.size()});
+  };
+
+  enter(src, -1);
+  while (!frames.empty())
+  {
+    Frame& top = frames.back();
+    if (top.next < top.end)
+    {
+      int u = top.vertex;
+      int v = neighbors[top.next++];
+      if (!discovered[v])
+        enter(v, u);
+      else if (!edge(u, v))
+        return false;
+    }
+    else
+    {
+      // all edges examined, so drop the frame and its neighbors
+      int v = top.vertex;
+      neighbors.resize(top.first);
+      frames.pop_back();
+      post(v);
+    }
+  }
+  return true;
+}
+
+
 #endif
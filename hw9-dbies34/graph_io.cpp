@@ -0,0 +1,179 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: graph_io.cpp
+// DATE: Spring 2021
+// DESC: Functions for reading graphs from the text edge-list format
+// and converting them to the binary CSR format
+//----------------------------------------------------------------------
+
+#include "graph_io.h"
+#include "csr_graph.h"
+#include "parallel.h"
+#include <charconv>
+#include <tuple>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+// files smaller than this per thread are parsed on one thread
+const long MIN_PARSE_CHUNK = 1 << 20;
+
+// skip spaces and line breaks
+static const char* skip_space(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+    {
+        p++;
+    }
+    return p;
+}
+
+// parse the next integer into value, returns nullptr if there is none
+static const char* parse_int(const char* p, const char* end, int& value)
+{
+    p = skip_space(p, end);
+    from_chars_result result = from_chars(p, end, value);
+    if (result.ec != errc())
+    {
+        return nullptr;
+    }
+    return result.ptr;
+}
+
+// parse all of the "v1 edge_label v2" lines between begin and end,
+// returns false if the text is not made up of whole edges between
+// vertices from 0 to vertex_count-1
+static bool parse_edges(const char* begin, const char* end, int vertex_count, Edges& edges)
+{
+    const char* p = skip_space(begin, end);
+    while (p < end)
+    {
+        int n1 = 0, w = 0, n2 = 0;
+        if ((p = parse_int(p, end, n1)) == nullptr ||
+            (p = parse_int(p, end, w)) == nullptr ||
+            (p = parse_int(p, end, n2)) == nullptr)
+        {
+            return false;
+        }
+        if (n1 < 0 || n2 < 0 || n1 >= vertex_count || n2 >= vertex_count)
+        {
+            return false;
+        }
+        edges.push_back(make_tuple(n1, w, n2));
+        p = skip_space(p, end);
+    }
+    return true;
+}
+
+// reads a text edge-list file
+bool read_text_graph(const std::string& filename, int& vertex_count, Edges& edges)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == -1 || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+    long size = info.st_size;
+    void* file = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (file == MAP_FAILED)
+    {
+        return false;
+    }
+    const char* text = (const char*) file;
+    const char* end = text + size;
+
+    // the header gives the vertex and edge counts
+    int edge_count = 0;
+    edges.clear();
+    const char* p = parse_int(text, end, vertex_count);
+    if (p == nullptr || (p = parse_int(p, end, edge_count)) == nullptr ||
+        vertex_count < 0 || edge_count < 0)
+    {
+        munmap(file, size);
+        return false;
+    }
+
+    // split the rest of the file into chunks that end at line breaks
+    int chunks = (end - p) / MIN_PARSE_CHUNK;
+    if (chunks > thread_count())
+        chunks = thread_count();
+    if (chunks < 1)
+        chunks = 1;
+    vector<const char*> bounds(chunks + 1);
+    bounds[0] = p;
+    bounds[chunks] = end;
+    for (int c = 1; c < chunks; ++c)
+    {
+        const char* q = p + (end - p) * c / chunks;
+        while (q < end && *q != '\n')
+            q++;
+        bounds[c] = q < bounds[c - 1] ? bounds[c - 1] : q;
+    }
+
+    // parse the chunks on separate threads
+    vector<Edges> chunkEdges(chunks);
+    vector<char> parsed(chunks);
+    parallel_tasks(chunks, [&](int c) {
+        chunkEdges[c].reserve((bounds[c + 1] - bounds[c]) / 8);
+        parsed[c] = parse_edges(bounds[c], bounds[c + 1], vertex_count, chunkEdges[c]);
+    });
+    munmap(file, size);
+
+    // join the chunks in file order, keeping only the first edge_count
+    // edges as the header says
+    vector<long> offsets(chunks + 1, 0);
+    for (int c = 0; c < chunks; ++c)
+    {
+        if (!parsed[c])
+        {
+            return false;
+        }
+        offsets[c + 1] = offsets[c] + chunkEdges[c].size();
+    }
+    if (offsets[chunks] < edge_count)
+    {
+        return false;
+    }
+    edges.resize(offsets[chunks]);
+    parallel_tasks(chunks, [&](int c) {
+        copy(chunkEdges[c].begin(), chunkEdges[c].end(), edges.begin() + offsets[c]);
+    });
+    edges.resize(edge_count);
+    return true;
+}
+
+// adds the edges of a text edge-list file to the given graph
+bool load_text_graph(Graph& g, const std::string& filename)
+{
+    int vertex_count = 0;
+    Edges edges;
+    if (!read_text_graph(filename, vertex_count, edges))
+    {
+        return false;
+    }
+    g.set_edges(edges);
+    return true;
+}
+
+// converts a text edge-list file into a binary CSR graph file
+bool convert_text_graph(const std::string& text_filename, const std::string& binary_filename)
+{
+    int vertex_count = 0;
+    Edges edges;
+    if (!read_text_graph(text_filename, vertex_count, edges))
+    {
+        return false;
+    }
+    CsrGraph g(vertex_count, edges);
+    return g.save(binary_filename);
+}
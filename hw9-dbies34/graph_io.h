@@ -0,0 +1,52 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: graph_io.h
+// DATE: Spring 2021
+// DESC: Functions for reading graphs from the text edge-list format
+// used by the examples, which is a "V E" header line followed by E
+// "v1 edge_label v2" lines, and converting them to the binary CSR
+// format (see csr_graph.h).
+//----------------------------------------------------------------------
+
+#ifndef GRAPH_IO_H
+#define GRAPH_IO_H
+
+#include "graph.h"
+#include <string>
+
+//----------------------------------------------------------------------
+// Reads a text edge-list file. The file is memory mapped and split into
+// chunks at line boundaries that are parsed on separate threads.
+//
+// Outputs:
+//   vertex_count -- the number of vertices from the header
+//   edges -- the (v1, edge_label, v2) edges in file order, replacing
+//            any edges it held
+// Returns:
+//   false if the file could not be read, a header count is negative,
+//   there are fewer edges than the header gives, or an edge has a
+//   vertex out of bounds
+//----------------------------------------------------------------------
+bool read_text_graph(const std::string& filename, int& vertex_count, Edges& edges);
+
+//----------------------------------------------------------------------
+// Adds the edges of a text edge-list file to the given graph using
+// set_edges, where the graph must already have the vertices.
+//
+// Returns:
+//   false if the file could not be read
+//----------------------------------------------------------------------
+bool load_text_graph(Graph& g, const std::string& filename);
+
+//----------------------------------------------------------------------
+// Converts a text edge-list file into a binary CSR graph file that can
+// be loaded with CsrGraph::load.
+//
+// Returns:
+//   false if the text file could not be read or the binary file could
+//   not be written
+//----------------------------------------------------------------------
+bool convert_text_graph(const std::string& text_filename, const std::string& binary_filename);
+
+
+#endif
@@ -15,6 +15,18 @@
 #include "graph.h"
 #include "adjacency_list.h"
 #include "adjacency_matrix.h"
+#include "csr_graph.h"
+#include "bit_adjacency_matrix.h"
+#include "parallel.h"
+#include "graph_io.h"
+#include "union_find.h"
+#include "connectivity_index.h"
+#include "bipartite_index.h"
+#include "reachability_index.h"
+#include "topological_order.h"
+#include <fstream>
+#include <random>
+#include <algorithm>
 
 
 using namespace std;
@@ -207,6 +219,771 @@ TEST(AdjacencyListTest, BigAllPairsShortestPaths) {
   ASSERT_EQ(9, weights[4][2]);
 }
 
+TEST(AdjacencyListTest, EdgeIndex) {
+  AdjacencyList g(5);
+  g.set_edge(0, 1, 1);
+  g.set_edge(2, 2, 1);
+  g.set_edge_index(true);
+  ASSERT_EQ(true, g.has_edge_index());
+  ASSERT_EQ(true, g.has_edge(2, 1));
+  ASSERT_EQ(false, g.has_edge(1, 2));
+  ASSERT_EQ(false, g.has_edge(-1, 1));
+  g.set_edge(3, 3, 1);
+  g.set_edge(0, 4, 1);
+  ASSERT_EQ(3, g.edge_count());
+  int label;
+  ASSERT_EQ(true, g.get_edge(0, 1, label));
+  ASSERT_EQ(4, label);
+  list<int> vertices;
+  g.connected_from(1, vertices);
+  ASSERT_EQ(3, vertices.size());
+  g.remove_edge(2, 1);
+  ASSERT_EQ(false, g.has_edge(2, 1));
+  // copies keep their own index
+  AdjacencyList h(g);
+  ASSERT_EQ(true, h.has_edge_index());
+  h.set_edge(0, 5, 1);
+  ASSERT_EQ(true, g.get_edge(0, 1, label));
+  ASSERT_EQ(4, label);
+  ASSERT_EQ(true, h.get_edge(0, 1, label));
+  ASSERT_EQ(5, label);
+  g.set_edge_index(false);
+  ASSERT_EQ(true, g.has_edge(3, 1));
+  ASSERT_EQ(false, g.has_edge(2, 1));
+}
+
+TEST(AdjacencyListTest, ManyEdgesReuseNodes) {
+  AdjacencyList g(100);
+  for (int i = 0; i < 100; ++i)
+    for (int j = 0; j < 30; ++j)
+      g.set_edge(i, j, (i + j) % 100);
+  ASSERT_EQ(3000, g.edge_count());
+  for (int i = 0; i < 100; i += 2)
+    for (int j = 0; j < 30; ++j)
+      g.remove_edge(i, (i + j) % 100);
+  ASSERT_EQ(1500, g.edge_count());
+  // removed nodes are reused by the new edges
+  for (int i = 0; i < 100; i += 2)
+    g.set_edge(i, -1, (i + 50) % 100);
+  ASSERT_EQ(1550, g.edge_count());
+  AdjacencyList h(g);
+  ASSERT_EQ(1550, h.edge_count());
+  int label;
+  ASSERT_EQ(true, h.get_edge(2, 52, label));
+  ASSERT_EQ(-1, label);
+  ASSERT_EQ(true, h.get_edge(3, 5, label));
+  ASSERT_EQ(2, label);
+  ASSERT_EQ(false, h.has_edge(2, 3));
+}
+
+TEST(AdjacencyListTest, BulkSetEdges) {
+  AdjacencyList g(5);
+  g.set_edge(0, 1, 1);
+  Edges edges;
+  edges.push_back(make_tuple(0, 2, 1));
+  edges.push_back(make_tuple(1, 3, 2));
+  edges.push_back(make_tuple(3, 4, 2));
+  edges.push_back(make_tuple(1, 5, 2));
+  edges.push_back(make_tuple(4, 6, 9));
+  g.set_edges(edges);
+  ASSERT_EQ(3, g.edge_count());
+  int label;
+  ASSERT_EQ(true, g.get_edge(0, 1, label));
+  ASSERT_EQ(2, label);
+  ASSERT_EQ(true, g.get_edge(1, 2, label));
+  ASSERT_EQ(5, label);
+  list<int> vertices;
+  g.connected_from(2, vertices);
+  ASSERT_EQ(2, vertices.size());
+}
+
+TEST(AdjacencyListTest, LargeBulkSetEdges) {
+  int n = 3000;
+  AdjacencyList g(n), h(n);
+  g.set_edge_index(true);
+  // force the parallel path even on single core machines
+  set_thread_count(4);
+  Edges edges;
+  for (int i = 0; i < 20000; ++i)
+    edges.push_back(make_tuple((i * 7) % n, i, (i * 13 + 5) % n));
+  g.set_edges(edges);
+  for (auto edge : edges)
+    h.set_edge(get<0>(edge), get<1>(edge), get<2>(edge));
+  ASSERT_EQ(h.edge_count(), g.edge_count());
+  for (auto edge : edges) {
+    int gl, hl;
+    ASSERT_EQ(true, g.get_edge(get<0>(edge), get<2>(edge), gl));
+    ASSERT_EQ(true, h.get_edge(get<0>(edge), get<2>(edge), hl));
+    ASSERT_EQ(hl, gl);
+  }
+  for (int v = 0; v < n; ++v) {
+    list<int> gv, hv;
+    g.connected_from(v, gv);
+    h.connected_from(v, hv);
+    ASSERT_EQ(hv.size(), gv.size());
+  }
+  set_thread_count(0);
+}
+
+TEST(AdjacencyListTest, DirectionOptimizingBfs) {
+  int n = 3000;
+  AdjacencyList g(n);
+  std::mt19937 rng(42);
+  for (int i = 0; i < 20000; ++i)
+    g.set_edge(rng() % n, 0, rng() % n);
+  for (bool dir : {true, false}) {
+    std::vector<int> expected, tree;
+    g.bfs(dir, 0, expected);
+    g.direction_optimizing_bfs(dir, 0, tree);
+    // same vertices found at the same depths, over edges of the graph
+    auto depth = [&](std::vector<int>& t, int v) {
+      int d = 0;
+      for (; t[v] != -1; v = t[v])
+        d++;
+      return d;
+    };
+    for (int v = 1; v < n; ++v) {
+      ASSERT_EQ(expected[v] == -1, tree[v] == -1);
+      if (tree[v] == -1)
+        continue;
+      ASSERT_EQ(depth(expected, v), depth(tree, v));
+      ASSERT_EQ(true, g.has_edge(tree[v], v) || (!dir && g.has_edge(v, tree[v])));
+    }
+  }
+  Map mapTree;
+  AdjacencyList h(4);
+  h.set_edge(0, 0, 1);
+  h.set_edge(2, 0, 1);
+  h.direction_optimizing_bfs(true, 0, mapTree);
+  ASSERT_EQ(2, mapTree.size());
+  ASSERT_EQ(0, mapTree[1]);
+}
+
+TEST(AdjacencyListTest, ParallelBfs) {
+  int n = 40000;
+  AdjacencyList g(n);
+  std::mt19937 rng(7);
+  Edges edges;
+  for (int i = 0; i < 160000; ++i)
+    edges.push_back(make_tuple(rng() % n, 0, rng() % n));
+  g.set_edges(edges);
+  // force the parallel path even on single core machines
+  set_thread_count(4);
+  for (bool dir : {true, false}) {
+    std::vector<int> expected, tree;
+    g.bfs(dir, 0, expected);
+    g.parallel_bfs(dir, 0, tree);
+    // same vertices found at the same depths, over edges of the graph
+    auto depth = [&](std::vector<int>& t, int v) {
+      int d = 0;
+      for (; t[v] != -1; v = t[v])
+        d++;
+      return d;
+    };
+    for (int v = 1; v < n; ++v) {
+      ASSERT_EQ(expected[v] == -1, tree[v] == -1);
+      if (tree[v] == -1)
+        continue;
+      ASSERT_EQ(depth(expected, v), depth(tree, v));
+      ASSERT_EQ(true, g.has_edge(tree[v], v) || (!dir && g.has_edge(v, tree[v])));
+    }
+  }
+  set_thread_count(0);
+}
+
+TEST(AdjacencyListTest, MultiSourceBfs) {
+  int n = 500;
+  AdjacencyList g(n);
+  std::mt19937 rng(3);
+  for (int i = 0; i < 1200; ++i)
+    g.set_edge(rng() % n, 0, rng() % n);
+  // three batches, including a repeated and an out of bounds source
+  std::vector<int> sources;
+  for (int i = 0; i < 130; ++i)
+    sources.push_back((i * 37) % n);
+  sources.push_back(0);
+  sources.push_back(n);
+  set_thread_count(4);
+  for (bool dir : {true, false}) {
+    std::vector<std::vector<int>> distances;
+    g.multi_source_bfs(dir, sources, distances);
+    ASSERT_EQ(sources.size(), distances.size());
+    for (int i = 0; i < (int) sources.size() - 1; ++i) {
+      std::vector<int> tree;
+      g.bfs(dir, sources[i], tree);
+      for (int v = 0; v < n; ++v) {
+        int d = -1;
+        if (v == sources[i] || tree[v] != -1) {
+          d = 0;
+          for (int u = v; u != sources[i]; u = tree[u])
+            d++;
+        }
+        ASSERT_EQ(d, distances[i][v]);
+      }
+    }
+    ASSERT_EQ(std::vector<int>(n, -1), distances.back());
+    // no sources gives no rows
+    g.multi_source_bfs(dir, std::vector<int>(), distances);
+    ASSERT_TRUE(distances.empty());
+  }
+  set_thread_count(0);
+}
+
+TEST(AdjacencyListTest, BidirectionalShortestPath) {
+  int n = 800;
+  AdjacencyList g(n);
+  std::mt19937 rng(11);
+  for (int i = 0; i < 1500; ++i)
+    g.set_edge(rng() % n, 0, rng() % n);
+  for (bool dir : {true, false}) {
+    for (int src = 0; src < n; src += 97) {
+      std::vector<int> tree;
+      g.bfs(dir, src, tree);
+      for (int dst = 1; dst < n; dst += 13) {
+        if (dst == src)
+          continue;
+        std::list<int> path;
+        g.shortest_path_length(dir, src, dst, path);
+        ASSERT_EQ(src, path.front());
+        if (tree[dst] == -1) {
+          ASSERT_EQ(1, path.size());
+          continue;
+        }
+        // same length as the bfs tree path, over edges of the graph
+        int length = 0;
+        for (int v = dst; v != src; v = tree[v])
+          length++;
+        ASSERT_EQ(length + 1, path.size());
+        ASSERT_EQ(dst, path.back());
+        for (auto it = path.begin(); std::next(it) != path.end(); ++it)
+          ASSERT_EQ(true, g.has_edge(*it, *std::next(it)) || (!dir && g.has_edge(*std::next(it), *it)));
+      }
+    }
+  }
+}
+
+TEST(AdjacencyListTest, ComponentEngines) {
+  int n = 20000;
+  AdjacencyList g(n);
+  std::mt19937 rng(5);
+  Edges edges;
+  for (int i = 0; i < 12000; ++i)
+    edges.push_back(make_tuple(rng() % n, 0, rng() % n));
+  g.set_edges(edges);
+  std::vector<int> expected, components;
+  int c = g.bfs_connected_components(expected);
+  ASSERT_EQ(c, g.union_find_connected_components(components));
+  ASSERT_EQ(expected, components);
+  // force the parallel path even on single core machines
+  set_thread_count(4);
+  ASSERT_EQ(c, g.parallel_connected_components(components));
+  ASSERT_EQ(expected, components);
+  set_thread_count(0);
+  UnionFind sets(4);
+  ASSERT_EQ(true, sets.join(0, 2));
+  ASSERT_EQ(false, sets.join(2, 0));
+  ASSERT_EQ(true, sets.same(0, 2));
+  ASSERT_EQ(false, sets.same(1, 2));
+  ASSERT_EQ(2, sets.set_size(2));
+  ASSERT_EQ(3, sets.set_count());
+}
+
+TEST(AdjacencyListTest, ConnectivityIndex) {
+  AdjacencyList g(6);
+  g.set_edge(0, 0, 1);
+  ConnectivityIndex index(g);
+  ASSERT_EQ(5, index.component_count());
+  ASSERT_EQ(true, index.connected(0, 1));
+  ASSERT_EQ(false, index.connected(1, 2));
+  g.set_edge(2, 0, 1);
+  g.set_edges({make_tuple(3, 0, 4), make_tuple(4, 0, 3)});
+  ASSERT_EQ(true, index.connected(0, 2));
+  ASSERT_EQ(index.component(3), index.component(4));
+  ASSERT_EQ(3, index.component_size(2));
+  ASSERT_EQ(3, index.component_count());
+  // a removed edge can split a component
+  g.remove_edge(2, 1);
+  ASSERT_EQ(false, index.connected(0, 2));
+  ASSERT_EQ(4, index.component_count());
+  g.remove_edge(3, 4);
+  ASSERT_EQ(true, index.connected(3, 4));
+  ASSERT_EQ(false, index.connected(0, 6));
+}
+
+TEST(AdjacencyListTest, ConnectivityIndexAfterAssignment) {
+  AdjacencyList g(2);
+  ConnectivityIndex index(g);
+  g.set_edge(0, 0, 1);
+  ASSERT_EQ(1, index.component_count());
+  // the graph grows, so the index is rebuilt at its new size
+  g = AdjacencyList(200000);
+  g.set_edge(150000, 0, 199999);
+  ASSERT_EQ(true, index.connected(150000, 199999));
+  ASSERT_EQ(false, index.connected(0, 1));
+  ASSERT_EQ(199999, index.component_count());
+  // and shrinks
+  g = AdjacencyList(3);
+  g.set_edge(2, 0, 1);
+  ASSERT_EQ(-1, index.component(150000));
+  ASSERT_EQ(2, index.component_size(1));
+}
+
+TEST(AdjacencyListTest, BipartiteOddCycle) {
+  AdjacencyList g(7);
+  g.set_edge(0, 0, 1);
+  g.set_edge(1, 0, 2);
+  g.set_edge(2, 0, 3);
+  g.set_edge(4, 0, 3);
+  g.set_edge(5, 0, 6);
+  std::vector<int> coloring, cycle;
+  ASSERT_EQ(true, g.bipartite_graph(coloring, cycle));
+  ASSERT_EQ(0, cycle.size());
+  ASSERT_EQ(1, coloring[5]);
+  // the cycle 1-2-3-4 is even
+  g.set_edge(4, 0, 1);
+  ASSERT_EQ(true, g.bipartite_graph(coloring, cycle));
+  // the witness must be an odd cycle over edges of the graph
+  g.set_edge(3, 0, 1);
+  ASSERT_EQ(false, g.bipartite_graph(coloring, cycle));
+  ASSERT_EQ(1, cycle.size() % 2);
+  for (int i = 0; i < (int) cycle.size(); ++i) {
+    int a = cycle[i], b = cycle[(i + 1) % cycle.size()];
+    ASSERT_EQ(true, g.has_edge(a, b) || g.has_edge(b, a));
+  }
+}
+
+TEST(AdjacencyListTest, ParallelBipartite) {
+  // many even cycles, one of which is made odd
+  int n = 20000;
+  AdjacencyList g(n);
+  for (int v = 0; v < n; ++v)
+    g.set_edge(v, 0, v % 10 == 9 ? v - 9 : v + 1);
+  set_thread_count(4);
+  std::vector<int> coloring, cycle;
+  ASSERT_EQ(true, g.bipartite_graph(coloring, cycle));
+  for (int v = 0; v < n; ++v)
+    ASSERT_EQ(v % 2 == 0 ? 1 : 0, coloring[v]);
+  g.set_edge(12345, 0, 12347);
+  ASSERT_EQ(false, g.bipartite_graph(coloring, cycle));
+  ASSERT_EQ(1, cycle.size() % 2);
+  for (int v : cycle)
+    ASSERT_EQ(1234, v / 10);
+  set_thread_count(0);
+}
+
+TEST(AdjacencyListTest, BipartiteIndex) {
+  int n = 40;
+  AdjacencyList g(n);
+  BipartiteIndex index(g);
+  ASSERT_EQ(true, index.bipartite());
+  std::mt19937 rng(9);
+  std::vector<int> coloring;
+  // each new edge agrees with a full recomputation
+  for (int i = 0; i < 60; ++i) {
+    int v1 = rng() % n, v2 = rng() % n;
+    g.set_edge(v1, 0, v2);
+    ASSERT_EQ(g.bipartite_graph(coloring), index.bipartite());
+    if (index.bipartite()) {
+      for (int u = 0; u < n; ++u)
+        g.for_each_connected_to(u, [&](int v, int) { ASSERT_NE(index.side(u), index.side(v)); });
+    }
+  }
+  // removing edges can make the graph bipartite again
+  for (int u = 0; u < n; ++u) {
+    std::list<int> out;
+    g.connected_to(u, out);
+    for (int v : out)
+      g.remove_edge(u, v);
+  }
+  ASSERT_EQ(true, index.bipartite());
+  g.set_edge(1, 0, 1);
+  ASSERT_EQ(false, index.bipartite());
+  ASSERT_EQ(-1, index.side(n));
+}
+
+TEST(AdjacencyListTest, BipartiteIndexAfterAssignment) {
+  AdjacencyList g(3);
+  BipartiteIndex index(g);
+  g.set_edge(0, 0, 1);
+  // the graph grows, so the index is rebuilt at its new size
+  g = AdjacencyList(100000);
+  g.set_edge(90000, 0, 99999);
+  g.set_edge(99999, 0, 50000);
+  ASSERT_EQ(true, index.bipartite());
+  ASSERT_EQ(index.side(90000), index.side(50000));
+  ASSERT_NE(index.side(90000), index.side(99999));
+  g.set_edge(50000, 0, 90000);
+  ASSERT_EQ(false, index.bipartite());
+  g = AdjacencyList(2);
+  ASSERT_EQ(true, index.bipartite());
+  ASSERT_EQ(-1, index.side(90000));
+}
+
+TEST(AdjacencyListTest, DepthFirstSearchEngine) {
+  // a hub connected to and from every other vertex
+  int n = 2000;
+  AdjacencyList g(n);
+  for (int v = 1; v < n; ++v) {
+    g.set_edge(0, 0, v);
+    g.set_edge(v, 0, 0);
+  }
+  g.set_edge(1, 0, 2);
+  std::vector<bool> discovered(n, false);
+  int entered = 0, examined = 0, finished = 0;
+  std::vector<int> post;
+  ASSERT_EQ(true, g.depth_first_search(Graph::OUT_EDGES, 0, discovered,
+      [&](int v, int parent) {
+        entered++;
+        ASSERT_EQ(true, v == 0 ? parent == -1 : g.has_edge(parent, v));
+      },
+      [&](int, int) { examined++; return true; },
+      [&](int v) { post.push_back(v); finished++; }));
+  // each edge is either a tree edge or examined once
+  ASSERT_EQ(n, entered);
+  ASSERT_EQ(g.edge_count() - (n - 1), examined);
+  ASSERT_EQ(n, finished);
+  ASSERT_EQ(0, post.back());
+  // stopping at the first examined edge
+  discovered.assign(n, false);
+  ASSERT_EQ(false, g.depth_first_search(Graph::IN_EDGES, 5, discovered,
+      [](int, int) {}, [](int, int) { return false; }, [](int) {}));
+}
+
+TEST(AdjacencyListTest, CondensationDag) {
+  int n = 120;
+  AdjacencyList g(n);
+  std::mt19937 rng(21);
+  for (int i = 0; i < 150; ++i)
+    g.set_edge(rng() % n, 0, rng() % n);
+  Condensation dag;
+  g.condensation(dag);
+  int c = dag.component_count();
+  ASSERT_EQ(n, dag.members.size());
+  // same component exactly when each reaches the other
+  std::vector<std::vector<int>> trees(n);
+  for (int v = 0; v < n; ++v)
+    g.bfs(true, v, trees[v]);
+  for (int u = 0; u < n; ++u) {
+    for (int v = 0; v < n; ++v) {
+      bool reach = u == v || (trees[u][v] != -1 && trees[v][u] != -1);
+      ASSERT_EQ(reach, dag.components[u] == dag.components[v]);
+    }
+  }
+  // every edge between components is in the dag, in topological order
+  int dagEdges = 0;
+  for (int u = 0; u < n; ++u) {
+    g.for_each_connected_to(u, [&](int v, int) {
+      int a = dag.components[u], b = dag.components[v];
+      if (a != b) {
+        ASSERT_LT(a, b);
+        ASSERT_EQ(true, std::binary_search(dag.targets.begin() + dag.offsets[a],
+                                           dag.targets.begin() + dag.offsets[a + 1], b));
+      }
+    });
+  }
+  for (int a = 0; a < c; ++a) {
+    dagEdges += dag.offsets[a + 1] - dag.offsets[a];
+    for (int k = dag.member_offsets[a]; k < dag.member_offsets[a + 1]; ++k)
+      ASSERT_EQ(a, dag.components[dag.members[k]]);
+  }
+  ASSERT_EQ(dag.targets.size(), dagEdges);
+  std::vector<int> components;
+  ASSERT_EQ(c, g.strongly_connected_components(components));
+}
+
+TEST(AdjacencyListTest, ParallelStronglyConnectedComponents) {
+  // one large component, chains of small cycles, and trimmed vertices
+  int n = 30000;
+  AdjacencyList g(n);
+  std::mt19937 rng(13);
+  Edges edges;
+  for (int i = 0; i < 30000; ++i)
+    edges.push_back(make_tuple(rng() % 5000, 0, rng() % 5000));
+  for (int v = 5000; v + 3 < n; v += 3) {
+    edges.push_back(make_tuple(v, 0, v + 1));
+    edges.push_back(make_tuple(v + 1, 0, v));
+    edges.push_back(make_tuple(v + 1, 0, v + 3));
+  }
+  for (int i = 0; i < 3000; ++i)
+    edges.push_back(make_tuple(rng() % n, 0, rng() % n));
+  g.set_edges(edges);
+  std::vector<int> expected, components;
+  int c = g.strongly_connected_components(expected);
+  set_thread_count(4);
+  ASSERT_EQ(c, g.parallel_strongly_connected_components(components));
+  set_thread_count(0);
+  // the same partition of the vertices
+  std::vector<int> first(c, -1);
+  for (int v = 0; v < n; ++v) {
+    if (first[expected[v]] == -1)
+      first[expected[v]] = components[v];
+    ASSERT_EQ(first[expected[v]], components[v]);
+  }
+  ASSERT_EQ(0, components[0]);
+}
+
+TEST(AdjacencyListTest, LargeTransitiveReduction) {
+  // a path with shortcuts reduces to the path
+  int n = 3000;
+  AdjacencyList g(n);
+  for (int v = 0; v < n; ++v)
+    for (int step : {1, 2, 5, 40})
+      if (v + step < n)
+        g.set_edge(v, 0, v + step);
+  AdjacencyList tr_g(n);
+  g.transitive_reduction(tr_g);
+  ASSERT_EQ(n - 1, tr_g.edge_count());
+  for (int v = 0; v + 1 < n; ++v)
+    ASSERT_EQ(true, tr_g.has_edge(v, v + 1));
+  // cycles are joined from their smallest vertex
+  AdjacencyList h(6);
+  h.set_edge(3, 0, 1);
+  h.set_edge(1, 0, 3);
+  h.set_edge(1, 0, 5);
+  h.set_edge(3, 0, 0);
+  h.set_edge(0, 0, 5);
+  h.set_edge(5, 0, 4);
+  h.set_edge(4, 0, 5);
+  AdjacencyList tr_h(6);
+  h.transitive_reduction(tr_h);
+  ASSERT_EQ(6, tr_h.edge_count());
+  ASSERT_EQ(true, tr_h.has_edge(1, 3) and tr_h.has_edge(3, 1));
+  ASSERT_EQ(true, tr_h.has_edge(4, 5) and tr_h.has_edge(5, 4));
+  ASSERT_EQ(true, tr_h.has_edge(1, 0) and tr_h.has_edge(0, 4));
+}
+
+TEST(AdjacencyListTest, BitTransitiveClosure) {
+  // random edges with cycles, checked against the search closure
+  int n = 9000;
+  AdjacencyList g(n);
+  std::mt19937 rng(21);
+  Edges edges;
+  for (int i = 0; i < 6000; ++i) {
+    int v1 = rng() % n;
+    // mostly forward edges so there are many levels
+    int v2 = i % 10 == 0 ? rng() % n : std::min(n - 1, v1 + 1 + (int) (rng() % 50));
+    edges.push_back(make_tuple(v1, 0, v2));
+  }
+  g.set_edges(edges);
+  BitAdjacencyMatrix closure(n);
+  set_thread_count(4);
+  g.bit_transitive_closure(closure);
+  set_thread_count(0);
+  std::vector<bool> discovered(n);
+  for (int i = 0; i < n; i += 97) {
+    std::fill(discovered.begin(), discovered.end(), false);
+    g.depth_first_search(Graph::OUT_EDGES, i, discovered, [](int, int) {},
+                         [](int, int) { return true; }, [](int) {});
+    discovered[i] = false;
+    for (int v = 0; v < n; ++v)
+      ASSERT_EQ((bool) discovered[v], closure.has_edge(i, v));
+  }
+  // a cycle reaches everything but itself
+  BitAdjacencyMatrix h(3), small(3);
+  h.set_edge(0, 0, 1);
+  h.set_edge(1, 0, 0);
+  h.set_edge(1, 0, 2);
+  h.bit_transitive_closure(small);
+  ASSERT_EQ(4, small.edge_count());
+  ASSERT_EQ(false, small.has_edge(0, 0));
+  ASSERT_EQ(true, small.has_edge(0, 2));
+  ASSERT_EQ(false, small.has_edge(2, 0));
+}
+
+TEST(AdjacencyListTest, ReachabilityIndex) {
+  int n = 2000;
+  AdjacencyList g(n);
+  std::mt19937 rng(24);
+  Edges edges;
+  for (int i = 0; i < 2500; ++i)
+    edges.push_back(make_tuple(rng() % n, 0, rng() % n));
+  g.set_edges(edges);
+  ReachabilityIndex index(g);
+  // check against a search from a sample of vertices
+  auto check = [&]() {
+    std::vector<bool> discovered(n);
+    for (int i = 0; i < n; i += 37) {
+      std::fill(discovered.begin(), discovered.end(), false);
+      g.depth_first_search(Graph::OUT_EDGES, i, discovered, [](int, int) {},
+                           [](int, int) { return true; }, [](int) {});
+      for (int v = 0; v < n; ++v)
+        ASSERT_EQ((bool) discovered[v], index.reaches(i, v));
+    }
+  };
+  check();
+  // edges that add paths and edges that do not
+  g.set_edge(5, 0, 6);
+  g.set_edge(6, 0, 5);
+  check();
+  g.remove_edge(5, 6);
+  check();
+  ASSERT_EQ(true, index.reaches(7, 7));
+  ASSERT_EQ(false, index.reaches(-1, 7));
+  ASSERT_EQ(false, index.reaches(7, n));
+  // the index is rebuilt after the graph is assigned to
+  g = AdjacencyList(3 * n);
+  g.set_edge(3 * n - 1, 0, n);
+  g.set_edge(n, 0, 0);
+  ASSERT_EQ(true, index.reaches(3 * n - 1, 0));
+  ASSERT_EQ(false, index.reaches(0, n));
+}
+
+TEST(AdjacencyListTest, TopologicalOrderRejectsCycles) {
+  int n = 300;
+  AdjacencyList g(n);
+  TopologicalOrder order(g, true);
+  std::mt19937 rng(25);
+  std::vector<bool> discovered(n);
+  for (int i = 0; i < 2000; ++i) {
+    int v1 = rng() % n;
+    int v2 = rng() % n;
+    bool had = g.has_edge(v1, v2);
+    g.set_edge(v1, 0, v2);
+    if (!had && !g.has_edge(v1, v2)) {
+      // only edges closing a cycle are kept out
+      std::fill(discovered.begin(), discovered.end(), false);
+      g.depth_first_search(Graph::OUT_EDGES, v2, discovered, [](int, int) {},
+                           [](int, int) { return true; }, [](int) {});
+      ASSERT_EQ(true, (bool) discovered[v1]);
+    }
+  }
+  ASSERT_EQ(true, g.acyclic(true));
+  ASSERT_EQ(true, order.acyclic());
+  for (int u = 0; u < n; ++u)
+    g.for_each_connected_to(u, [&](int v, int) {
+      ASSERT_LT(order.position(u), order.position(v));
+    });
+  std::vector<int> vertices;
+  order.order(vertices);
+  for (int p = 0; p < n; ++p)
+    ASSERT_EQ(p, order.position(vertices[p]));
+}
+
+TEST(AdjacencyListTest, TopologicalOrderRejectsAfterRebuild) {
+  // start cyclic, then remove the edge closing the cycle
+  AdjacencyList g(3);
+  g.set_edge(0, 0, 1);
+  g.set_edge(1, 0, 0);
+  TopologicalOrder order(g, true);
+  ASSERT_EQ(false, order.acyclic());
+  g.remove_edge(1, 0);
+  g.set_edge(1, 0, 2);
+  g.set_edge(2, 0, 0);
+  ASSERT_EQ(false, g.has_edge(2, 0));
+  ASSERT_EQ(true, order.acyclic());
+  // the order follows the graph when it is assigned to
+  g = AdjacencyList(5);
+  g.set_edge(4, 0, 3);
+  g.set_edge(3, 0, 4);
+  ASSERT_EQ(false, g.has_edge(3, 4));
+  ASSERT_LT(order.position(4), order.position(3));
+}
+
+TEST(AdjacencyListTest, GraphMatchingSimple) {
+  AdjacencyList g(4);
+  g.set_edge(0, 0, 3);
+  g.set_edge(0, 0, 2);
+  g.set_edge(1, 0, 2);
+  AdjacencyList m(4);
+  ASSERT_EQ(true, g.bipartite_graph_matching(m));
+  ASSERT_EQ(2, m.edge_count());
+  ASSERT_EQ(true, m.has_edge(0, 3) or m.has_edge(3, 0));
+  ASSERT_EQ(true, m.has_edge(1, 2) or m.has_edge(2, 1));
+}
+
+TEST(AdjacencyListTest, GraphMatchingBook) {
+  // the first edges found from 0 and 1 must be flipped to match all
+  AdjacencyList g(8);
+  g.set_edge(0, 0, 4);
+  g.set_edge(0, 0, 5);
+  g.set_edge(1, 0, 4);
+  g.set_edge(1, 0, 5);
+  g.set_edge(1, 0, 6);
+  g.set_edge(2, 0, 5);
+  g.set_edge(3, 0, 6);
+  g.set_edge(3, 0, 7);
+  AdjacencyList m(8);
+  ASSERT_EQ(true, g.bipartite_graph_matching(m));
+  ASSERT_EQ(4, m.edge_count());
+  ASSERT_EQ(true, m.has_edge(0, 4) or m.has_edge(4, 0));
+  ASSERT_EQ(true, m.has_edge(1, 6) or m.has_edge(6, 1));
+  ASSERT_EQ(true, m.has_edge(2, 5) or m.has_edge(5, 2));
+  ASSERT_EQ(true, m.has_edge(3, 7) or m.has_edge(7, 3));
+}
+
+TEST(AdjacencyListTest, NonBipartiteGraphMatching) {
+  AdjacencyList g(4);
+  g.set_edge(0, 0, 3);
+  g.set_edge(0, 0, 2);
+  g.set_edge(1, 0, 2);
+  g.set_edge(3, 0, 2);
+  AdjacencyList m(4);
+  ASSERT_EQ(false, g.bipartite_graph_matching(m));
+  ASSERT_EQ(0, m.edge_count());
+}
+
+TEST(AdjacencyListTest, VisitNeighbors) {
+  AdjacencyList g(4);
+  g.set_edge(0, 5, 1);
+  g.set_edge(0, 6, 2);
+  g.set_edge(3, 7, 0);
+  int labelSum = 0;
+  Set out;
+  g.for_each_connected_to(0, [&](int v, int label) {
+    out.insert(v);
+    labelSum += label;
+  });
+  ASSERT_EQ(Set({1, 2}), out);
+  ASSERT_EQ(11, labelSum);
+  int inCount = 0;
+  g.for_each_connected_from(0, [&](int v, int label) {
+    ASSERT_EQ(3, v);
+    ASSERT_EQ(7, label);
+    inCount++;
+  });
+  ASSERT_EQ(1, inCount);
+  int adjCount = 0;
+  g.for_each_adjacent(0, [&](int, int) { adjCount++; });
+  ASSERT_EQ(3, adjCount);
+  // stops at the first match
+  int visited = 0;
+  ASSERT_EQ(true, g.any_connected_to(0, [&](int, int) { return ++visited == 1; }));
+  ASSERT_EQ(1, visited);
+  ASSERT_EQ(false, g.any_connected_from(0, [&](int v, int) { return v == 1; }));
+}
+
+TEST(AdjacencyListTest, DenseSearchResults) {
+  AdjacencyList g(6);
+  g.set_edge(0, 0, 1);
+  g.set_edge(1, 0, 2);
+  g.set_edge(0, 0, 3);
+  g.set_edge(4, 0, 5);
+  std::vector<int> tree;
+  g.bfs(true, 0, tree);
+  ASSERT_EQ(std::vector<int>({-1, 0, 1, 0, -1, -1}), tree);
+  g.dfs(true, 0, tree);
+  ASSERT_EQ(-1, tree[0]);
+  ASSERT_EQ(1, tree[2]);
+  ASSERT_EQ(-1, tree[4]);
+  // the map versions leave out vertices not found
+  Map mapTree;
+  g.bfs(true, 0, mapTree);
+  ASSERT_EQ(4, mapTree.size());
+  ASSERT_EQ(-1, mapTree[0]);
+  std::vector<int> components;
+  ASSERT_EQ(2, g.bfs_connected_components(components));
+  ASSERT_EQ(std::vector<int>({0, 0, 0, 0, 1, 1}), components);
+  std::vector<int> coloring;
+  ASSERT_EQ(true, g.bipartite_graph(coloring));
+  ASSERT_EQ(coloring[4], 1 - coloring[5]);
+  ASSERT_EQ(coloring[0], 1 - coloring[3]);
+  std::vector<int> ordering;
+  g.dfs_topological_sort(ordering);
+  ASSERT_LT(ordering[0], ordering[1]);
+  ASSERT_LT(ordering[1], ordering[2]);
+  ASSERT_LT(ordering[4], ordering[5]);
+}
+
 //----------------------------------------------------------------------
 // Adjacency Matrix Tests
 //----------------------------------------------------------------------
@@ -355,6 +1132,391 @@ TEST(AdjacencyMatrixTest, BigAllPairsShortestPaths) {
   ASSERT_EQ(9, weights[4][2]);
 }
 
+TEST(AdjacencyMatrixTest, BulkSetEdges) {
+  AdjacencyMatrix g(5);
+  g.set_edge(0, 1, 1);
+  Edges edges;
+  edges.push_back(make_tuple(0, 2, 1));
+  edges.push_back(make_tuple(1, 3, 2));
+  edges.push_back(make_tuple(3, 4, 2));
+  edges.push_back(make_tuple(1, 5, 2));
+  edges.push_back(make_tuple(4, 6, 9));
+  g.set_edges(edges);
+  ASSERT_EQ(3, g.edge_count());
+  int label;
+  ASSERT_EQ(true, g.get_edge(0, 1, label));
+  ASSERT_EQ(2, label);
+  ASSERT_EQ(true, g.get_edge(1, 2, label));
+  ASSERT_EQ(5, label);
+  list<int> vertices;
+  g.connected_from(2, vertices);
+  ASSERT_EQ(2, vertices.size());
+}
+
+TEST(AdjacencyMatrixTest, VisitNeighbors) {
+  AdjacencyMatrix g(4);
+  g.set_edge(0, 5, 1);
+  g.set_edge(0, 6, 2);
+  g.set_edge(3, 7, 0);
+  int labelSum = 0;
+  Set out;
+  g.for_each_connected_to(0, [&](int v, int label) {
+    out.insert(v);
+    labelSum += label;
+  });
+  ASSERT_EQ(Set({1, 2}), out);
+  ASSERT_EQ(11, labelSum);
+  int inCount = 0;
+  g.for_each_connected_from(0, [&](int v, int label) {
+    ASSERT_EQ(3, v);
+    ASSERT_EQ(7, label);
+    inCount++;
+  });
+  ASSERT_EQ(1, inCount);
+  int adjCount = 0;
+  g.for_each_adjacent(0, [&](int, int) { adjCount++; });
+  ASSERT_EQ(3, adjCount);
+  // stops at the first match
+  int visited = 0;
+  ASSERT_EQ(true, g.any_connected_to(0, [&](int, int) { return ++visited == 1; }));
+  ASSERT_EQ(1, visited);
+  ASSERT_EQ(false, g.any_connected_from(0, [&](int v, int) { return v == 1; }));
+}
+
+TEST(AdjacencyMatrixTest, DensePathCosts) {
+  AdjacencyMatrix g(5);
+  g.set_edge(0, 4, 1);
+  g.set_edge(0, 1, 2);
+  g.set_edge(2, 2, 1);
+  g.set_edge(1, 3, 3);
+  std::vector<int> costs;
+  g.dijkstra_shortest_path(0, costs);
+  int inf = std::numeric_limits<int>::max();
+  ASSERT_EQ(std::vector<int>({0, 3, 1, 6, inf}), costs);
+  ASSERT_EQ(true, g.bellman_ford_shortest_path(0, costs));
+  ASSERT_EQ(std::vector<int>({0, 3, 1, 6, inf}), costs);
+  Map mapCosts;
+  g.dijkstra_shortest_path(0, mapCosts);
+  ASSERT_EQ(5, mapCosts.size());
+  ASSERT_EQ(6, mapCosts[3]);
+  std::vector<int> components;
+  g.set_edge(3, 0, 2);
+  ASSERT_EQ(3, g.strongly_connected_components(components));
+  ASSERT_EQ(components[1], components[2]);
+  ASSERT_EQ(components[1], components[3]);
+  ASSERT_NE(components[0], components[1]);
+  ASSERT_NE(components[4], components[1]);
+}
+
+TEST(AdjacencyMatrixTest, ConnectivityIndex) {
+  AdjacencyMatrix g(4);
+  ConnectivityIndex index(g);
+  g.set_edge(0, 1, 3);
+  g.set_edge(0, 2, 3);
+  ASSERT_EQ(3, index.component_count());
+  ASSERT_EQ(true, index.connected(3, 0));
+  g.remove_edge(0, 3);
+  ASSERT_EQ(false, index.connected(3, 0));
+}
+
+TEST(AdjacencyMatrixTest, TopologicalOrderFlagsCycles) {
+  AdjacencyMatrix g(4);
+  TopologicalOrder order(g, false);
+  g.set_edge(2, 0, 1);
+  g.set_edge(1, 0, 0);
+  g.set_edge(3, 0, 2);
+  ASSERT_EQ(true, order.acyclic());
+  std::vector<int> vertices;
+  order.order(vertices);
+  ASSERT_EQ(std::vector<int>({3, 2, 1, 0}), vertices);
+  // the edge closing the cycle is still added
+  g.set_edge(0, 0, 3);
+  ASSERT_EQ(true, g.has_edge(0, 3));
+  ASSERT_EQ(false, order.acyclic());
+  ASSERT_EQ(-1, order.position(0));
+  g.remove_edge(1, 0);
+  ASSERT_EQ(true, order.acyclic());
+  ASSERT_LT(order.position(0), order.position(3));
+  g.set_edge(2, 0, 2);
+  ASSERT_EQ(false, order.acyclic());
+}
+
+TEST(AdjacencyMatrixTest, GraphMatchingBook) {
+  AdjacencyMatrix g(8);
+  g.set_edge(0, 0, 4);
+  g.set_edge(0, 0, 5);
+  g.set_edge(1, 0, 4);
+  g.set_edge(1, 0, 5);
+  g.set_edge(1, 0, 6);
+  g.set_edge(2, 0, 5);
+  g.set_edge(3, 0, 6);
+  g.set_edge(3, 0, 7);
+  AdjacencyMatrix m(8);
+  ASSERT_EQ(true, g.bipartite_graph_matching(m));
+  ASSERT_EQ(4, m.edge_count());
+  ASSERT_EQ(true, m.has_edge(1, 6) or m.has_edge(6, 1));
+  ASSERT_EQ(true, m.has_edge(3, 7) or m.has_edge(7, 3));
+}
+
+TEST(AdjacencyMatrixTest, CopyAndUpdateEdges) {
+  AdjacencyMatrix g(70);
+  g.set_edge(0, 1, 69);
+  g.set_edge(69, 2, 0);
+  g.set_edge(0, 3, 69);
+  ASSERT_EQ(2, g.edge_count());
+  AdjacencyMatrix h(g);
+  h.set_edge(0, 4, 69);
+  h.remove_edge(69, 0);
+  // the copy does not share edges with the original
+  int label;
+  ASSERT_EQ(true, g.get_edge(0, 69, label));
+  ASSERT_EQ(3, label);
+  ASSERT_EQ(true, g.has_edge(69, 0));
+  ASSERT_EQ(true, h.get_edge(0, 69, label));
+  ASSERT_EQ(4, label);
+  ASSERT_EQ(false, h.has_edge(69, 0));
+  ASSERT_EQ(1, h.edge_count());
+  g = h;
+  ASSERT_EQ(false, g.has_edge(69, 0));
+  ASSERT_EQ(1, g.edge_count());
+}
+
+//----------------------------------------------------------------------
+// CSR Graph Tests
+//----------------------------------------------------------------------
+
+TEST(CsrGraphTest, BasicEdges) {
+  Edges edges;
+  edges.push_back(make_tuple(0, 5, 1));
+  edges.push_back(make_tuple(2, 7, 0));
+  edges.push_back(make_tuple(0, 3, 2));
+  edges.push_back(make_tuple(0, 4, 1));
+  edges.push_back(make_tuple(3, 1, 4));
+  CsrGraph g(4, edges);
+  // repeated edge is kept once and out of bounds edge is dropped
+  ASSERT_EQ(4, g.vertex_count());
+  ASSERT_EQ(3, g.edge_count());
+  int label;
+  ASSERT_EQ(true, g.get_edge(0, 1, label));
+  ASSERT_EQ(4, label);
+  ASSERT_EQ(true, g.get_edge(2, 0, label));
+  ASSERT_EQ(7, label);
+  ASSERT_EQ(false, g.has_edge(1, 0));
+  ASSERT_EQ(false, g.has_edge(3, 4));
+  // immutable
+  g.set_edge(1, 0, 3);
+  g.remove_edge(0, 1);
+  ASSERT_EQ(false, g.has_edge(1, 3));
+  ASSERT_EQ(true, g.has_edge(0, 1));
+}
+
+TEST(CsrGraphTest, ConnectedToAndFrom) {
+  Edges edges;
+  edges.push_back(make_tuple(0, 0, 3));
+  edges.push_back(make_tuple(0, 0, 1));
+  edges.push_back(make_tuple(2, 0, 1));
+  edges.push_back(make_tuple(1, 0, 3));
+  CsrGraph g(4, edges);
+  list<int> vertices;
+  g.connected_to(0, vertices);
+  ASSERT_EQ(list<int>({1, 3}), vertices);
+  vertices.clear();
+  g.connected_from(1, vertices);
+  ASSERT_EQ(list<int>({0, 2}), vertices);
+  vertices.clear();
+  g.adjacent(1, vertices);
+  ASSERT_EQ(3, vertices.size());
+  // copies are deep
+  CsrGraph h(g);
+  ASSERT_EQ(4, h.edge_count());
+  ASSERT_EQ(true, h.has_edge(1, 3));
+}
+
+TEST(CsrGraphTest, AlgorithmsOnCsr) {
+  Edges edges;
+  edges.push_back(make_tuple(0, 0, 1));
+  edges.push_back(make_tuple(1, 0, 2));
+  edges.push_back(make_tuple(2, 0, 0));
+  edges.push_back(make_tuple(2, 0, 3));
+  CsrGraph g(5, edges);
+  Map tree;
+  g.bfs(true, 0, tree);
+  ASSERT_EQ(4, tree.size());
+  ASSERT_EQ(2, tree[3]);
+  Map components;
+  g.strongly_connected_components(components);
+  ASSERT_EQ(components[0], components[1]);
+  ASSERT_EQ(components[0], components[2]);
+  ASSERT_NE(components[0], components[3]);
+  ASSERT_NE(components[3], components[4]);
+}
+
+TEST(CsrGraphTest, SaveAndLoadBinary) {
+  string text_file = testing::TempDir() + "hw9_graph.txt";
+  string binary_file = testing::TempDir() + "hw9_graph.bin";
+  ofstream f(text_file);
+  f << "4 5" << endl;
+  f << "0 3 1" << endl << "1 4 2" << endl << "2 5 0" << endl;
+  f << "2 6 3" << endl << "0 7 1" << endl;
+  f.close();
+  ASSERT_EQ(true, convert_text_graph(text_file, binary_file));
+  CsrGraph* g = CsrGraph::load(binary_file);
+  ASSERT_NE(nullptr, g);
+  ASSERT_EQ(4, g->vertex_count());
+  ASSERT_EQ(4, g->edge_count());
+  int label;
+  ASSERT_EQ(true, g->get_edge(0, 1, label));
+  ASSERT_EQ(7, label);
+  list<int> vertices;
+  g->connected_from(0, vertices);
+  ASSERT_EQ(list<int>({2}), vertices);
+  // copies of a mapped graph own their arrays
+  CsrGraph h(*g);
+  delete g;
+  ASSERT_EQ(true, h.get_edge(2, 3, label));
+  ASSERT_EQ(6, label);
+  // text files are not valid binary files
+  ASSERT_EQ(nullptr, CsrGraph::load(text_file));
+  ASSERT_EQ(nullptr, CsrGraph::load(testing::TempDir() + "hw9_missing.bin"));
+}
+
+TEST(CsrGraphTest, LoadCorruptBinary) {
+  string binary_file = testing::TempDir() + "hw9_corrupt.bin";
+  CsrGraph g(4, {make_tuple(0, 1, 1), make_tuple(1, 2, 2), make_tuple(2, 3, 3)});
+  // the header is 24 bytes, followed by the 5 out offsets and the 3
+  // out targets
+  auto corrupt = [&](long position, int value) {
+    ASSERT_EQ(true, g.save(binary_file));
+    fstream f(binary_file, ios::in | ios::out | ios::binary);
+    f.seekp(position);
+    f.write((const char*) &value, sizeof(value));
+  };
+  ASSERT_EQ(true, g.save(binary_file));
+  CsrGraph* h = CsrGraph::load(binary_file);
+  ASSERT_NE(nullptr, h);
+  delete h;
+  // a target out of bounds
+  corrupt(24 + 5 * 4, 4);
+  ASSERT_EQ(nullptr, CsrGraph::load(binary_file));
+  // a decreasing offset
+  corrupt(24 + 2 * 4, 0);
+  ASSERT_EQ(nullptr, CsrGraph::load(binary_file));
+  // offsets not ending at the edge count
+  corrupt(24 + 4 * 4, 2);
+  ASSERT_EQ(nullptr, CsrGraph::load(binary_file));
+  // a negative in source
+  corrupt(24 + (5 + 3 + 3 + 5) * 4, -1);
+  ASSERT_EQ(nullptr, CsrGraph::load(binary_file));
+}
+
+TEST(CsrGraphTest, ParallelTextLoad) {
+  // large enough to be split into several chunks
+  string text_file = testing::TempDir() + "hw9_large_graph.txt";
+  int n = 1000, m = 200000;
+  ofstream f(text_file);
+  f << n << " " << m << endl;
+  for (int i = 0; i < m; ++i)
+    f << (i % n) << " " << -i << " " << (i * 7 + 3) % n << endl;
+  f.close();
+  set_thread_count(4);
+  int vertex_count = 0;
+  Edges edges;
+  ASSERT_EQ(true, read_text_graph(text_file, vertex_count, edges));
+  set_thread_count(0);
+  ASSERT_EQ(n, vertex_count);
+  ASSERT_EQ(m, edges.size());
+  for (int i = 0; i < m; ++i)
+    ASSERT_EQ(make_tuple(i % n, -i, (i * 7 + 3) % n), edges[i]);
+  // the last label given for an edge is kept
+  AdjacencyList g(n);
+  ASSERT_EQ(true, load_text_graph(g, text_file));
+  CsrGraph h(n, edges);
+  ASSERT_EQ(h.edge_count(), g.edge_count());
+  int label;
+  ASSERT_EQ(true, g.get_edge(0, 3, label));
+  ASSERT_EQ(-199000, label);
+  ASSERT_EQ(true, h.get_edge(0, 3, label));
+  ASSERT_EQ(-199000, label);
+  ASSERT_EQ(false, read_text_graph(testing::TempDir() + "hw9_missing.txt", vertex_count, edges));
+}
+
+TEST(CsrGraphTest, InvalidTextHeader) {
+  string text_file = testing::TempDir() + "hw9_invalid.txt";
+  auto read = [&](const string& text, Edges& edges) {
+    ofstream f(text_file);
+    f << text;
+    f.close();
+    int vertex_count = 0;
+    return read_text_graph(text_file, vertex_count, edges);
+  };
+  Edges edges = {make_tuple(0, 0, 1)};
+  // the edges read replace the edges given
+  ASSERT_EQ(true, read("3 2\n0 1 1\n1 2 2\n", edges));
+  ASSERT_EQ(Edges({make_tuple(0, 1, 1), make_tuple(1, 2, 2)}), edges);
+  ASSERT_EQ(false, read("3 -1\n0 1 1\n", edges));
+  ASSERT_EQ(false, read("-3 1\n0 1 1\n", edges));
+  ASSERT_EQ(false, read("3 1\n0 1 3\n", edges));
+  ASSERT_EQ(false, read("3 1\n-1 1 2\n", edges));
+  ASSERT_EQ(false, read("3 2\n0 1 1\n", edges));
+}
+
+//----------------------------------------------------------------------
+// Bit Adjacency Matrix Tests
+//----------------------------------------------------------------------
+
+TEST(BitAdjacencyMatrixTest, BasicEdges) {
+  BitAdjacencyMatrix g(100);
+  g.set_edge(0, 5, 70);
+  g.set_edge(70, 0, 3);
+  g.set_edge(99, -2, 70);
+  g.set_edge(0, 6, 70);
+  ASSERT_EQ(3, g.edge_count());
+  int label;
+  ASSERT_EQ(true, g.get_edge(0, 70, label));
+  ASSERT_EQ(6, label);
+  ASSERT_EQ(true, g.get_edge(70, 3, label));
+  ASSERT_EQ(0, label);
+  ASSERT_EQ(false, g.has_edge(3, 70));
+  list<int> vertices;
+  g.connected_from(70, vertices);
+  ASSERT_EQ(list<int>({0, 99}), vertices);
+  g.remove_edge(0, 70);
+  ASSERT_EQ(2, g.edge_count());
+  ASSERT_EQ(false, g.has_edge(0, 70));
+  int labelSum = 0;
+  g.for_each_connected_from(70, [&](int, int label) { labelSum += label; });
+  ASSERT_EQ(-2, labelSum);
+  // a removed edge added back has label 0, and copies keep the labels
+  g.set_edge(0, 0, 70);
+  ASSERT_EQ(true, g.get_edge(0, 70, label));
+  ASSERT_EQ(0, label);
+  BitAdjacencyMatrix copy(g);
+  ASSERT_EQ(true, copy.get_edge(99, 70, label));
+  ASSERT_EQ(-2, label);
+}
+
+TEST(BitAdjacencyMatrixTest, RowOperations) {
+  BitAdjacencyMatrix g(130);
+  g.set_edge(0, 0, 1);
+  g.set_edge(0, 0, 65);
+  g.set_edge(0, 0, 129);
+  g.set_edge(2, 0, 65);
+  g.set_edge(2, 0, 129);
+  g.set_edge(2, 0, 3);
+  ASSERT_EQ(3, g.row_words());
+  ASSERT_EQ(2, g.common_out_count(0, 2));
+  vector<uint64_t> row(g.row_words(), 0);
+  g.out_row_and(0, 2, row.data());
+  ASSERT_EQ(0, row[0]);
+  ASSERT_EQ((uint64_t) 1 << 1, row[1]);
+  ASSERT_EQ((uint64_t) 1 << 1, row[2]);
+  g.out_row_or(0, row.data());
+  g.out_row_or(2, row.data());
+  ASSERT_EQ(((uint64_t) 1 << 1) | ((uint64_t) 1 << 3), row[0]);
+  // column scans use the transposed rows
+  ASSERT_EQ((uint64_t) 1 | ((uint64_t) 1 << 2), g.in_row(129)[0]);
+}
+
 
 int main(int argc, char** argv)
 {
@@ -0,0 +1,251 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: parallel.h
+// DATE: Spring 2021
+// DESC: Helpers for splitting loops over vertices or edges across
+// threads
+//----------------------------------------------------------------------
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// loops with fewer iterations than this per thread are not split
+const int MIN_PARALLEL_RANGE = 4096;
+
+// the thread count set by set_thread_count (0 if not set)
+inline int& thread_count_setting()
+{
+  static int count = 0;
+  return count;
+}
+
+// use the given number of threads for parallel loops, or one thread
+// per hardware thread if count is 0 (the default)
+inline void set_thread_count(int count)
+{
+  thread_count_setting() = count;
+}
+
+// number of threads available for parallel loops
+inline int thread_count()
+{
+  int n = thread_count_setting();
+  if (n == 0)
+    n = std::thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+}
+
+// number of ranges parallel_for splits a loop of count iterations into
+inline int parallel_ranges(int count)
+{
+  int ranges = count / MIN_PARALLEL_RANGE;
+  if (ranges > thread_count())
+    ranges = thread_count();
+  return ranges > 1 ? ranges : 1;
+}
+
+// true on a thread while it runs a task of a pool loop
+inline bool& inside_pool()
+{
+  thread_local bool inside = false;
+  return inside;
+}
+
+// threads kept waiting between parallel loops, so that loops run many
+// times (such as once per level of a search) do not start new threads
+// each time
+class ThreadPool
+{
+public:
+
+  // the pool shared by all parallel loops
+  static ThreadPool& instance()
+  {
+    static ThreadPool pool;
+    return pool;
+  }
+
+  // stop and join the pool threads
+  ~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers)
+      t.join();
+  }
+
+  // calls body(task) for task 0 on the calling thread and each task
+  // from 1 to tasks-1 on its own pool thread, adding threads as needed.
+  // Returns false without calling body if the pool is already running
+  // a loop. Must not be called from a task of a pool loop.
+  bool run(int tasks, const std::function<void(int)>& body)
+  {
+    assert(tasks >= 1 && !inside_pool());
+    std::unique_lock<std::mutex> claim(busy, std::try_to_lock);
+    if (!claim.owns_lock())
+      return false;
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      // new threads wait for the loop after the last one
+      while ((int) workers.size() < tasks - 1)
+        workers.push_back(std::thread(&ThreadPool::work, this, (int) workers.size(), generation));
+      job = &body;
+      job_tasks = tasks;
+      unfinished = tasks - 1;
+      generation++;
+    }
+    wake.notify_all();
+    inside_pool() = true;
+    body(0);
+    inside_pool() = false;
+    std::unique_lock<std::mutex> guard(lock);
+    done.wait(guard, [&] { return unfinished == 0; });
+    job = nullptr;
+    return true;
+  }
+
+private:
+
+  // held by the loop using the pool
+  std::mutex busy;
+
+  // guards the fields below
+  std::mutex lock;
+  std::condition_variable wake;
+  std::condition_variable done;
+  std::vector<std::thread> workers;
+
+  // the current loop, its number of tasks, and the number of its pool
+  // tasks not yet done
+  const std::function<void(int)>* job = nullptr;
+  int job_tasks = 0;
+  int unfinished = 0;
+
+  // incremented for each loop, and set when the pool is destroyed
+  long generation = 0;
+  bool stopping = false;
+
+  ThreadPool() {}
+
+  // pool thread index runs task index+1 of each loop after seen
+  void work(int index, long seen)
+  {
+    inside_pool() = true;
+    std::unique_lock<std::mutex> guard(lock);
+    while (true)
+    {
+      wake.wait(guard, [&] { return stopping || generation != seen; });
+      if (stopping)
+        return;
+      seen = generation;
+      if (index + 1 < job_tasks)
+      {
+        const std::function<void(int)>& body = *job;
+        guard.unlock();
+        body(index + 1);
+        guard.lock();
+        if (--unfinished == 0)
+          done.notify_all();
+      }
+    }
+  }
+};
+
+// calls body(task) for each task from 0 to tasks-1, each task on its
+// own thread (from the pool when it is free)
+template<typename F>
+void parallel_tasks(int tasks, F body)
+{
+  if (tasks <= 0)
+    return;
+  if (tasks == 1)
+  {
+    body(0);
+    return;
+  }
+  // a loop nested in a pool task cannot wait on the pool it is part of
+  if (!inside_pool())
+  {
+    std::function<void(int)> job = [&](int t) { body(t); };
+    if (ThreadPool::instance().run(tasks, job))
+      return;
+  }
+  // the pool is in use, so start threads for this loop
+  std::vector<std::thread> threads;
+  for (int t = 0; t < tasks; ++t)
+    threads.push_back(std::thread(body, t));
+  for (std::thread& t : threads)
+    t.join();
+}
+
+// calls body(range, begin, end) for parallel_ranges(count) contiguous
+// ranges covering 0 to count-1, each range on its own thread
+template<typename F>
+void parallel_for(int count, F body)
+{
+  int ranges = parallel_ranges(count);
+  parallel_tasks(ranges, [&](int r) {
+    int begin = (long) count * r / ranges;
+    int end = (long) count * (r + 1) / ranges;
+    body(r, begin, end);
+  });
+}
+
+// groups the items 0 to count-1 by bucket (from 0 to bucket_count-1),
+// where key(i) gives the bucket of item i or -1 to leave it out. On
+// return the items of bucket b are in items[offsets[b]] to
+// items[offsets[b+1]-1], in no particular order.
+template<typename Key>
+void parallel_bucket(int count, int bucket_count, Key key,
+                     std::vector<int>& offsets, std::vector<int>& items)
+{
+  std::vector<std::atomic<int>> sizes(bucket_count);
+  parallel_for(bucket_count, [&](int, int begin, int end) {
+    for (int b = begin; b < end; ++b)
+      sizes[b].store(0, std::memory_order_relaxed);
+  });
+
+  // count the bucket sizes
+  parallel_for(count, [&](int, int begin, int end) {
+    for (int i = begin; i < end; ++i)
+    {
+      int b = key(i);
+      if (b != -1)
+        sizes[b].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  // prefix sum the sizes into offsets, leaving each size counter as
+  // the next free slot of its bucket
+  offsets.assign(bucket_count + 1, 0);
+  for (int b = 0; b < bucket_count; ++b)
+  {
+    offsets[b + 1] = offsets[b] + sizes[b].load(std::memory_order_relaxed);
+    sizes[b].store(offsets[b], std::memory_order_relaxed);
+  }
+
+  // scatter the items into their buckets
+  items.resize(offsets[bucket_count]);
+  parallel_for(count, [&](int, int begin, int end) {
+    for (int i = begin; i < end; ++i)
+    {
+      int b = key(i);
+      if (b != -1)
+        items[sizes[b].fetch_add(1, std::memory_order_relaxed)] = i;
+    }
+  });
+}
+
+
+#endif
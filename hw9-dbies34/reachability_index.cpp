@@ -0,0 +1,210 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: reachability_index.cpp
+// DATE: Spring 2021
+// DESC: Reachability queries on a directed graph without building its
+// transitive closure
+//----------------------------------------------------------------------
+
+#include "reachability_index.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <utility>
+
+using namespace std;
+
+// build the index and follow the graph
+ReachabilityIndex::ReachabilityIndex(Graph& graph, int interval_count)
+    : graph(graph), intervals(max(interval_count, 1)), stamp(0)
+{
+    rebuild();
+    graph.add_listener(this);
+}
+
+// stop following the graph
+ReachabilityIndex::~ReachabilityIndex()
+{
+    graph.remove_listener(this);
+}
+
+// check if there is a path from v1 to v2
+bool ReachabilityIndex::reaches(int v1, int v2)
+{
+    refresh();
+    // check if out of bounds
+    int size = dag.components.size();
+    if (v1 < 0 || v2 < 0 || v1 >= size || v2 >= size)
+    {
+        return false;
+    }
+    int c1 = dag.components[v1];
+    int c2 = dag.components[v2];
+    if (c1 == c2)
+    {
+        return true;
+    }
+    if (!may_reach(c1, c2))
+    {
+        return false;
+    }
+
+    // search from c1, only going to components that may reach c2
+    if (++stamp == 0)
+    {
+        fill(seen.begin(), seen.end(), 0);
+        stamp = 1;
+    }
+    vector<int> stack;
+    stack.push_back(c1);
+    seen[c1] = stamp;
+    while (!stack.empty())
+    {
+        int c = stack.back();
+        stack.pop_back();
+        for (int k = dag.offsets[c]; k < dag.offsets[c + 1]; ++k)
+        {
+            int d = dag.targets[k];
+            if (d == c2)
+            {
+                return true;
+            }
+            if (seen[d] != stamp && may_reach(d, c2))
+            {
+                seen[d] = stamp;
+                stack.push_back(d);
+            }
+        }
+    }
+    return false;
+}
+
+// mark the index to be rebuilt
+void ReachabilityIndex::edge_added(int, int)
+{
+    stale = true;
+}
+
+// mark the index to be rebuilt
+void ReachabilityIndex::edge_removed(int, int)
+{
+    stale = true;
+}
+
+// mark the index to be rebuilt
+void ReachabilityIndex::graph_assigned()
+{
+    stale = true;
+}
+
+// rebuild the index from the edges of the graph
+void ReachabilityIndex::rebuild()
+{
+    graph.condensation(dag);
+    int count = dag.component_count();
+
+    // components are in topological order, so going backward the
+    // targets of each component are done before it
+    level.assign(count, 0);
+    for (int c = count - 1; c >= 0; --c)
+    {
+        for (int k = dag.offsets[c]; k < dag.offsets[c + 1]; ++k)
+        {
+            level[c] = max(level[c], level[dag.targets[k]] + 1);
+        }
+    }
+
+    low.assign((long) count * intervals, 0);
+    post.assign((long) count * intervals, 0);
+    for (int t = 0; t < intervals; ++t)
+    {
+        label(t);
+    }
+    seen.assign(count, 0);
+    stamp = 0;
+    stale = false;
+}
+
+// check if component c1 might reach component c2 by the labels
+bool ReachabilityIndex::may_reach(int c1, int c2) const
+{
+    // a path goes forward in topological order and down in level
+    if (c1 > c2 || level[c1] <= level[c2])
+    {
+        return false;
+    }
+    // and each interval of c2 is inside the interval of c1
+    long i1 = (long) c1 * intervals;
+    long i2 = (long) c2 * intervals;
+    for (int t = 0; t < intervals; ++t)
+    {
+        if (low[i2 + t] < low[i1 + t] || post[i2 + t] > post[i1 + t])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// label the components with interval t, from a depth first search
+// with the roots in random order and the targets of each component in
+// forward or backward order
+void ReachabilityIndex::label(int t)
+{
+    int count = dag.component_count();
+    vector<int> roots(count);
+    iota(roots.begin(), roots.end(), 0);
+    mt19937 rng(t + 1);
+    shuffle(roots.begin(), roots.end(), rng);
+    bool backward = t % 2 == 1;
+
+    // each frame is a component and the number of its targets tried
+    vector<bool> discovered(count, false);
+    vector<pair<int, int>> frames;
+    int rank = 0;
+    for (int root : roots)
+    {
+        if (discovered[root])
+        {
+            continue;
+        }
+        discovered[root] = true;
+        frames.push_back(make_pair(root, 0));
+        while (!frames.empty())
+        {
+            int c = frames.back().first;
+            int i = frames.back().second++;
+            int first = dag.offsets[c];
+            int last = dag.offsets[c + 1];
+            if (i < last - first)
+            {
+                int d = dag.targets[backward ? last - 1 - i : first + i];
+                if (!discovered[d])
+                {
+                    discovered[d] = true;
+                    frames.push_back(make_pair(d, 0));
+                }
+                continue;
+            }
+
+            // all targets are labeled, so c covers their intervals
+            frames.pop_back();
+            long ci = (long) c * intervals + t;
+            low[ci] = rank;
+            for (int k = first; k < last; ++k)
+            {
+                low[ci] = min(low[ci], low[(long) dag.targets[k] * intervals + t]);
+            }
+            post[ci] = rank++;
+        }
+    }
+}
+
+// rebuild the index if it is stale
+void ReachabilityIndex::refresh()
+{
+    if (stale)
+    {
+        rebuild();
+    }
+}
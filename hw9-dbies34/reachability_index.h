@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: reachability_index.h
+// DATE: Spring 2021
+// DESC: Reachability queries on a directed graph without building its
+// transitive closure. The index labels the condensation of the graph
+// with a few (low, post) intervals from randomized depth first
+// searches (GRAIL), where v1 can only reach v2 if each interval of v2
+// is inside the matching interval of v1, and with the topological
+// order and level of each component. Queries the labels cannot answer
+// fall back to a search pruned by the same tests.
+//----------------------------------------------------------------------
+
+#ifndef REACHABILITY_INDEX_H
+#define REACHABILITY_INDEX_H
+
+#include "graph.h"
+#include <vector>
+
+
+class ReachabilityIndex : public EdgeListener
+{
+public:
+
+  // build the index from the current edges of the graph with the given
+  // number of intervals per component, and follow its edge changes
+  // until the index is destroyed
+  ReachabilityIndex(Graph& graph, int interval_count = 3);
+
+  // stop following the graph
+  ~ReachabilityIndex();
+
+  // the index follows a single graph, so it is not copied
+  ReachabilityIndex(const ReachabilityIndex& rhs) = delete;
+  ReachabilityIndex& operator=(const ReachabilityIndex& rhs) = delete;
+
+  // check if there is a path from v1 to v2 (a vertex always reaches
+  // itself)
+  bool reaches(int v1, int v2);
+
+  // a new edge marks the index to be rebuilt on the next query
+  void edge_added(int v1, int v2);
+
+  // a removed edge marks the index to be rebuilt on the next query
+  void edge_removed(int v1, int v2);
+
+  // mark the index to be rebuilt on the next query
+  void graph_assigned();
+
+  // rebuild the index from the edges of the graph
+  void rebuild();
+
+private:
+
+  Graph& graph;
+
+  // number of intervals per component
+  int intervals;
+
+  // the strongly connected components in topological order
+  Condensation dag;
+
+  // length of the longest path from each component in the condensation
+  std::vector<int> level;
+
+  // interval t of component c is low[c*intervals+t] to
+  // post[c*intervals+t]
+  std::vector<int> low;
+  std::vector<int> post;
+
+  // components marked with the current stamp were seen by the current
+  // fallback search
+  std::vector<int> seen;
+  int stamp;
+
+  // true if the graph changed in a way the index does not reflect
+  bool stale;
+
+  // check if component c1 might reach component c2 by the labels
+  bool may_reach(int c1, int c2) const;
+
+  // label the components with interval t
+  void label(int t);
+
+  // rebuild the index if it is stale
+  void refresh();
+
+};
+
+
+#endif
@@ -0,0 +1,234 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: topological_order.cpp
+// DATE: Spring 2021
+// DESC: Topological order of a directed graph kept up to date as edges
+// are added (Pearce-Kelly)
+//----------------------------------------------------------------------
+
+#include "topological_order.h"
+#include <algorithm>
+
+using namespace std;
+
+// build the order and follow the graph
+TopologicalOrder::TopologicalOrder(Graph& graph, bool reject_cycles)
+    : graph(graph), reject(reject_cycles)
+{
+    rebuild();
+    graph.add_listener(this);
+}
+
+// stop following the graph
+TopologicalOrder::~TopologicalOrder()
+{
+    graph.remove_listener(this);
+}
+
+// check if the graph has no directed cycle
+bool TopologicalOrder::acyclic()
+{
+    refresh();
+    return is_acyclic;
+}
+
+// position of v in the order
+int TopologicalOrder::position(int v)
+{
+    refresh();
+    // check if out of bounds
+    if (v < 0 || v >= (int) positions.size())
+    {
+        return -1;
+    }
+    return is_acyclic ? positions[v] : -1;
+}
+
+// the vertices in topological order
+void TopologicalOrder::order(std::vector<int>& vertices)
+{
+    refresh();
+    vertices.clear();
+    if (is_acyclic)
+    {
+        vertices = this -> vertices;
+    }
+}
+
+// keep out a new edge that would close a cycle
+bool TopologicalOrder::allow_edge(int v1, int v2)
+{
+    if (!reject)
+    {
+        return true;
+    }
+    // the order must be current to check the edge against it, and a
+    // cyclic graph has no order to keep
+    refresh();
+    if (!is_acyclic)
+    {
+        return true;
+    }
+    return insert(v1, v2);
+}
+
+// order the ends of a new edge or flag the cycle it closes
+void TopologicalOrder::edge_added(int v1, int v2)
+{
+    // rejected cycles were already checked by allow_edge
+    if (reject)
+    {
+        return;
+    }
+    // a rebuilt order already has the edge
+    if (stale)
+    {
+        rebuild();
+        return;
+    }
+    if (is_acyclic && !insert(v1, v2))
+    {
+        is_acyclic = false;
+    }
+}
+
+// a cyclic graph may become acyclic, so it is rebuilt
+void TopologicalOrder::edge_removed(int, int)
+{
+    if (!is_acyclic)
+    {
+        stale = true;
+    }
+}
+
+// mark the order to be rebuilt
+void TopologicalOrder::graph_assigned()
+{
+    stale = true;
+}
+
+// rebuild the order from the edges of the graph
+void TopologicalOrder::rebuild()
+{
+    int size = graph.vertex_count();
+    Condensation dag;
+    graph.condensation(dag);
+
+    // the graph is acyclic if each component is a single vertex without
+    // a self loop, and then the components are in topological order
+    is_acyclic = dag.component_count() == size;
+    for (int v = 0; v < size && is_acyclic; ++v)
+    {
+        is_acyclic = !graph.has_edge(v, v);
+    }
+    positions = dag.components;
+    vertices.assign(size, 0);
+    for (int v = 0; v < size; ++v)
+    {
+        vertices[positions[v]] = v;
+    }
+    marked.assign(size, false);
+    stale = false;
+}
+
+// move the vertices between v2 and v1 so that v1 comes before v2
+bool TopologicalOrder::insert(int v1, int v2)
+{
+    // an edge the order has no room for means the graph changed size
+    int size = positions.size();
+    if (v1 < 0 || v2 < 0 || v1 >= size || v2 >= size)
+    {
+        stale = true;
+        return true;
+    }
+    if (v1 == v2)
+    {
+        return false;
+    }
+    int lower = positions[v2];
+    int upper = positions[v1];
+    // the order already holds for the edge
+    if (upper < lower)
+    {
+        return true;
+    }
+
+    // search forward from v2 through the vertices before v1, where
+    // reaching v1 means the edge closes a cycle
+    vector<int> forward, stack;
+    bool cycle = false;
+    stack.push_back(v2);
+    marked[v2] = true;
+    while (!stack.empty() && !cycle)
+    {
+        int u = stack.back();
+        stack.pop_back();
+        forward.push_back(u);
+        cycle = graph.any_connected_to(u, [&](int w, int) {
+            if (w == v1)
+                return true;
+            if (!marked[w] && positions[w] < upper)
+            {
+                marked[w] = true;
+                stack.push_back(w);
+            }
+            return false;
+        });
+    }
+    if (cycle)
+    {
+        for (int u : forward)
+            marked[u] = false;
+        for (int u : stack)
+            marked[u] = false;
+        return false;
+    }
+
+    // search backward from v1 through the vertices after v2
+    vector<int> backward;
+    stack.push_back(v1);
+    marked[v1] = true;
+    while (!stack.empty())
+    {
+        int u = stack.back();
+        stack.pop_back();
+        backward.push_back(u);
+        graph.for_each_connected_from(u, [&](int w, int) {
+            if (!marked[w] && positions[w] > lower)
+            {
+                marked[w] = true;
+                stack.push_back(w);
+            }
+        });
+    }
+
+    // the backward vertices take the first of the freed positions and
+    // the forward vertices the rest, each group keeping its own order
+    auto byPosition = [&](int a, int b) { return positions[a] < positions[b]; };
+    sort(backward.begin(), backward.end(), byPosition);
+    sort(forward.begin(), forward.end(), byPosition);
+    vector<int> moved(backward);
+    moved.insert(moved.end(), forward.begin(), forward.end());
+    vector<int> freed;
+    for (int u : moved)
+    {
+        freed.push_back(positions[u]);
+        marked[u] = false;
+    }
+    sort(freed.begin(), freed.end());
+    for (int i = 0; i < (int) moved.size(); ++i)
+    {
+        positions[moved[i]] = freed[i];
+        vertices[freed[i]] = moved[i];
+    }
+    return true;
+}
+
+// rebuild the order if it is stale
+void TopologicalOrder::refresh()
+{
+    if (stale)
+    {
+        rebuild();
+    }
+}
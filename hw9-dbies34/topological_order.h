@@ -0,0 +1,92 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: topological_order.h
+// DATE: Spring 2021
+// DESC: Topological order of a directed graph kept up to date as edges
+// are added (Pearce-Kelly), so that each new edge is checked for a
+// cycle by searching only the vertices between its ends in the order
+//----------------------------------------------------------------------
+
+#ifndef TOPOLOGICAL_ORDER_H
+#define TOPOLOGICAL_ORDER_H
+
+#include "graph.h"
+#include <vector>
+
+
+class TopologicalOrder : public EdgeListener
+{
+public:
+
+  // build the order from the current edges of the graph and follow its
+  // edge changes until the order is destroyed. If reject_cycles is
+  // true, new edges that would close a cycle are kept out of the graph,
+  // otherwise they are added and the graph is flagged as cyclic.
+  TopologicalOrder(Graph& graph, bool reject_cycles);
+
+  // stop following the graph
+  ~TopologicalOrder();
+
+  // the order follows a single graph, so it is not copied
+  TopologicalOrder(const TopologicalOrder& rhs) = delete;
+  TopologicalOrder& operator=(const TopologicalOrder& rhs) = delete;
+
+  // check if the graph has no directed cycle (including self loops)
+  bool acyclic();
+
+  // position of v in the order, where each edge goes from a lower to a
+  // higher position (-1 if out of bounds or the graph is cyclic)
+  int position(int v);
+
+  // the vertices in topological order (empty if the graph is cyclic)
+  void order(std::vector<int>& vertices);
+
+  // when rejecting cycles, move the ends of a new edge into order,
+  // returning false if the edge would close a cycle
+  bool allow_edge(int v1, int v2);
+
+  // when flagging cycles, move the ends of a new edge into order or
+  // flag the graph as cyclic
+  void edge_added(int v1, int v2);
+
+  // removing an edge keeps the order, but a cyclic graph is marked to
+  // be rebuilt on the next query
+  void edge_removed(int v1, int v2);
+
+  // mark the order to be rebuilt on the next query or new edge
+  void graph_assigned();
+
+  // rebuild the order from the edges of the graph
+  void rebuild();
+
+private:
+
+  Graph& graph;
+
+  // true if edges closing a cycle are kept out of the graph
+  bool reject;
+
+  // true if the graph has no cycle, in which case vertex v is at
+  // positions[v] and vertices[p] is the vertex at position p
+  bool is_acyclic;
+  std::vector<int> positions;
+  std::vector<int> vertices;
+
+  // vertices found by the searches of the current insert
+  std::vector<bool> marked;
+
+  // true if the graph changed in a way the order does not reflect
+  bool stale;
+
+  // reorder the vertices between v2 and v1 so that v1 comes before v2,
+  // returning false (with the order unchanged) if v2 reaches v1. An
+  // edge out of bounds of the order marks it stale instead.
+  bool insert(int v1, int v2);
+
+  // rebuild the order if it is stale
+  void refresh();
+
+};
+
+
+#endif
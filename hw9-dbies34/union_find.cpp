@@ -0,0 +1,190 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: union_find.cpp
+// DATE: Spring 2021
+// DESC: Disjoint sets of the elements 0 to n-1 with path compression
+// and union by size, and a variant that also splits each set into two
+// sides
+//----------------------------------------------------------------------
+
+#include "union_find.h"
+
+using namespace std;
+
+// each of the count elements starts in its own set
+UnionFind::UnionFind(int count)
+{
+    // check for negative count
+    if (count < 0)
+    {
+        count = 0;
+    }
+    parents.resize(count);
+    sizes.resize(count);
+    reset();
+}
+
+// put each element back in its own set
+void UnionFind::reset()
+{
+    for (int x = 0; x < (int) parents.size(); ++x)
+    {
+        parents[x] = x;
+        sizes[x] = 1;
+    }
+    sets = parents.size();
+}
+
+// the representative element of the set holding x
+int UnionFind::find(int x)
+{
+    int root = x;
+    while (parents[root] != root)
+    {
+        root = parents[root];
+    }
+    // point the path straight at the root
+    while (parents[x] != root)
+    {
+        int next = parents[x];
+        parents[x] = root;
+        x = next;
+    }
+    return root;
+}
+
+// merge the sets holding x and y
+bool UnionFind::join(int x, int y)
+{
+    x = find(x);
+    y = find(y);
+    if (x == y)
+    {
+        return false;
+    }
+    // hang the smaller set under the larger one
+    if (sizes[x] < sizes[y])
+    {
+        int temp = x;
+        x = y;
+        y = temp;
+    }
+    parents[y] = x;
+    sizes[x] += sizes[y];
+    sets--;
+    return true;
+}
+
+// check if x and y are in the same set
+bool UnionFind::same(int x, int y)
+{
+    return find(x) == find(y);
+}
+
+// number of elements in the set holding x
+int UnionFind::set_size(int x)
+{
+    return sizes[find(x)];
+}
+
+// number of disjoint sets
+int UnionFind::set_count() const
+{
+    return sets;
+}
+
+// number of elements
+int UnionFind::size() const
+{
+    return parents.size();
+}
+
+// each of the count elements starts in its own set
+ParityUnionFind::ParityUnionFind(int count)
+{
+    // check for negative count
+    if (count < 0)
+    {
+        count = 0;
+    }
+    parents.resize(count);
+    parities.resize(count);
+    sizes.resize(count);
+    reset();
+}
+
+// put each element back in its own set
+void ParityUnionFind::reset()
+{
+    for (int x = 0; x < (int) parents.size(); ++x)
+    {
+        parents[x] = x;
+        parities[x] = 0;
+        sizes[x] = 1;
+    }
+    sets = parents.size();
+}
+
+// the representative element of the set holding x and the side of x
+// relative to it
+int ParityUnionFind::find(int x, int& parity)
+{
+    int root = x;
+    parity = 0;
+    while (parents[root] != root)
+    {
+        parity ^= parities[root];
+        root = parents[root];
+    }
+    // point the path straight at the root, keeping the side of each
+    // element relative to the root
+    int side = parity;
+    while (parents[x] != root)
+    {
+        int next = parents[x];
+        int nextSide = side ^ parities[x];
+        parents[x] = root;
+        parities[x] = side;
+        x = next;
+        side = nextSide;
+    }
+    return root;
+}
+
+// merge the sets holding x and y with x and y on the given sides
+bool ParityUnionFind::join(int x, int y, bool odd)
+{
+    int px, py;
+    x = find(x, px);
+    y = find(y, py);
+    int want = odd ? 1 : 0;
+    if (x == y)
+    {
+        return (px ^ py) == want;
+    }
+    // hang the smaller set under the larger one, choosing its side so
+    // that the two elements end up on the wanted sides
+    if (sizes[x] < sizes[y])
+    {
+        int temp = x;
+        x = y;
+        y = temp;
+    }
+    parents[y] = x;
+    parities[y] = px ^ py ^ want;
+    sizes[x] += sizes[y];
+    sets--;
+    return true;
+}
+
+// number of disjoint sets
+int ParityUnionFind::set_count() const
+{
+    return sets;
+}
+
+// number of elements
+int ParityUnionFind::size() const
+{
+    return parents.size();
+}
@@ -0,0 +1,102 @@
+//----------------------------------------------------------------------
+// NAME: Drew Bies
+// FILE: union_find.h
+// DATE: Spring 2021
+// DESC: Disjoint sets of the elements 0 to n-1 with path compression
+// and union by size, and a variant that also splits each set into two
+// sides
+//----------------------------------------------------------------------
+
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <vector>
+
+
+class UnionFind
+{
+public:
+
+  // each of the count elements starts in its own set
+  UnionFind(int count);
+
+  // put each element back in its own set
+  void reset();
+
+  // the representative element of the set holding x
+  int find(int x);
+
+  // merge the sets holding x and y, returns false if they were
+  // already the same set
+  bool join(int x, int y);
+
+  // check if x and y are in the same set
+  bool same(int x, int y);
+
+  // number of elements in the set holding x
+  int set_size(int x);
+
+  // number of disjoint sets
+  int set_count() const;
+
+  // number of elements
+  int size() const;
+
+private:
+
+  // parent of each element (a representative is its own parent)
+  std::vector<int> parents;
+
+  // number of elements in each set, kept at the representative
+  std::vector<int> sizes;
+
+  int sets;
+
+};
+
+
+// disjoint sets where each element also has a side (0 or 1) relative
+// to the other elements of its set, for keeping 2-colorings
+class ParityUnionFind
+{
+public:
+
+  // each of the count elements starts in its own set
+  ParityUnionFind(int count);
+
+  // put each element back in its own set
+  void reset();
+
+  // the representative element of the set holding x, where the output
+  // parameter is the side of x relative to the representative
+  int find(int x, int& parity);
+
+  // merge the sets holding x and y so that x and y are on different
+  // sides if odd is true and on the same side otherwise. Returns false
+  // (leaving the sets unchanged) if x and y are already in the same
+  // set on the wrong sides.
+  bool join(int x, int y, bool odd);
+
+  // number of disjoint sets
+  int set_count() const;
+
+  // number of elements
+  int size() const;
+
+private:
+
+  // parent of each element (a representative is its own parent)
+  std::vector<int> parents;
+
+  // side of each element relative to its parent
+  std::vector<int> parities;
+
+  // number of elements in each set, kept at the representative
+  std::vector<int> sizes;
+
+  int sets;
+
+};
+
+
+#endif